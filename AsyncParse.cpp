@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/AsyncParse.h"
+#else
+#   include "AsyncParse.h"
+#endif
+
+#if (FNR_HAS_COROUTINES==1) && defined(__linux__)
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+EventLoop::EventLoop() : epoll_(epoll_create1(EPOLL_CLOEXEC)), waiting_(0)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+EventLoop::~EventLoop()
+{
+    if (epoll_ >= 0)
+        close(epoll_);
+}
+
+//-----------------------------------------------------------------------------
+void EventLoop::watch(int fd, std::coroutine_handle<> handle)
+{
+    // one-shot, so a descriptor is re-armed by its next wait
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = handle.address();
+
+    if (epoll_ >= 0 && fd >= 0 &&
+        (epoll_ctl(epoll_, EPOLL_CTL_MOD, fd, &event) == 0 ||
+         (errno == ENOENT && epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) == 0)))
+    {
+        ++waiting_;
+        return;
+    }
+
+    // not pollable (no descriptor, a regular file): resume it on the next
+    // turn, its read will not block for long
+    ready_.push_back(handle);
+}
+
+//-----------------------------------------------------------------------------
+void EventLoop::run()
+{
+    epoll_event events[64];
+    std::vector<std::coroutine_handle<> > turn;
+
+    while (waiting_ || !ready_.empty())
+    {
+        // a coroutine queued again while it runs waits for the next turn,
+        // so polled descriptors get their turn in between
+        turn.swap(ready_);
+        for (size_t i = 0; i < turn.size(); ++i)
+            turn[i].resume();
+        turn.clear();
+
+        if (!waiting_)
+            continue;
+
+        const int count = epoll_wait(epoll_, events, 64, ready_.empty() ? -1 : 0);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        waiting_ -= count;
+        for (int i = 0; i < count; ++i)
+            std::coroutine_handle<>::from_address(events[i].data.ptr).resume();
+    }
+}
+
+} // end of fnr
+
+#endif // FNR_HAS_COROUTINES && __linux__
@@ -0,0 +1,243 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__ASYNCPARSE_H
+#define FAST_NUMBER_READER__ASYNCPARSE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/PullParser.h"
+#   include "FastNumberReader/ByteSource.h"
+#else
+#   include "PullParser.h"
+#   include "ByteSource.h"
+#endif
+
+#if (FNR_HAS_COROUTINES==1)
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Lazy generator, for (T value : ReadNumbers<T>(source)) { ... }
+template <typename T>
+class Generator
+{
+public:
+    struct promise_type
+    {
+        T value_;
+
+        Generator get_return_object() { return Generator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return std::suspend_always(); }
+        std::suspend_always final_suspend() noexcept { return std::suspend_always(); }
+        std::suspend_always yield_value(T value) noexcept { value_ = value; return std::suspend_always(); }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    class iterator
+    {
+    public:
+        explicit iterator(Handle handle) : handle_(handle) {}
+
+        T operator*() const { return handle_.promise().value_; }
+        iterator& operator++() { handle_.resume(); return *this; }
+        bool operator!=(const iterator&) const { return !handle_.done(); }
+
+    private:
+        Handle handle_;
+    };
+
+    Generator(Generator&& other) noexcept : handle_(other.handle_) { other.handle_ = Handle(); }
+    ~Generator() { if (handle_) handle_.destroy(); }
+
+    iterator begin() { handle_.resume(); return iterator(handle_); }
+    iterator end() { return iterator(handle_); }
+
+private:
+    explicit Generator(Handle handle) : handle_(handle) {}
+    Generator(const Generator&);
+    Generator& operator=(const Generator&);
+
+    Handle handle_;
+};
+
+//-----------------------------------------------------------------------------
+// Values of a blocking source; malformed tokens are skipped, and a read
+// error or kWouldBlock ends the sequence like the end of input does.
+template <typename T>
+Generator<T> ReadNumbers(ByteSource& source, DelimiterSet delimiters = DelimiterSet(),
+                         size_t chunkSize = 1 << 16)
+{
+    PullParser<T> parser(delimiters);
+    std::vector<CharType> buffer(chunkSize);
+    T value;
+
+    for (;;)
+    {
+        const ePullStatus status = parser.next(value);
+        if (kPullValue == status)
+        {
+            co_yield value;
+        }
+        else if (kPullNeedInput == status)
+        {
+            const long count = source.read(&buffer[0], buffer.size());
+            if (count > 0)
+                parser.feed(&buffer[0], (size_t)count);
+            else
+                parser.finish();
+        }
+        else if (kPullEnd == status)
+        {
+            co_return;
+        }
+    }
+}
+
+#if defined(__linux__)
+
+//-----------------------------------------------------------------------------
+// Single-threaded epoll loop resuming coroutines whose descriptor became
+// readable. Many streams are parsed on one thread, none of them blocks it.
+class EventLoop
+{
+public:
+    EventLoop();
+    ~EventLoop();
+
+    // Resumes handle from run() once fd is readable, or on the next turn of
+    // the loop if fd cannot be polled (-1, a regular file).
+    void watch(int fd, std::coroutine_handle<> handle);
+    // Returns when no coroutine waits any more.
+    void run();
+
+private:
+    EventLoop(const EventLoop&);
+    EventLoop& operator=(const EventLoop&);
+
+    int epoll_;
+    size_t waiting_;
+    std::vector<std::coroutine_handle<> > ready_;
+};
+
+//-----------------------------------------------------------------------------
+// co_await ReadChunk(loop, source, buffer, capacity) gives what
+// source.read() does, suspending while a non-blocking source has no data.
+// A source without a descriptor is tried again on the next turn of the
+// loop, so it never keeps the other coroutines from running. kWouldBlock
+// may still come back after a spurious wakeup.
+class ReadChunk
+{
+public:
+    ReadChunk(EventLoop& loop, ByteSource& source, CharType* buffer, size_t capacity) :
+        loop_(loop), source_(source), buffer_(buffer), capacity_(capacity), count_(0) {}
+
+    bool await_ready()
+    {
+        count_ = source_.read(buffer_, capacity_);
+        return count_ != ByteSource::kWouldBlock;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        loop_.watch(source_.descriptor(), handle);
+    }
+
+    long await_resume()
+    {
+        if (ByteSource::kWouldBlock == count_)
+            count_ = source_.read(buffer_, capacity_);
+        return count_;
+    }
+
+private:
+    EventLoop& loop_;
+    ByteSource& source_;
+    CharType* buffer_;
+    size_t capacity_;
+    long count_;
+};
+
+//-----------------------------------------------------------------------------
+// Fire-and-forget coroutine, runs until its first wait right away.
+struct AsyncTask
+{
+    struct promise_type
+    {
+        AsyncTask get_return_object() { return AsyncTask(); }
+        std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+        std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+//-----------------------------------------------------------------------------
+// Parses source on loop, calling sink(value) for every number. Tokens cut
+// between chunks are carried as reader state while the coroutine waits.
+template <typename T, typename Sink>
+AsyncTask ParseAsync(EventLoop& loop, ByteSource& source, Sink sink,
+                     DelimiterSet delimiters = DelimiterSet(), size_t chunkSize = 1 << 16)
+{
+    PullParser<T> parser(delimiters);
+    std::vector<CharType> buffer(chunkSize);
+    T value;
+
+    for (;;)
+    {
+        const ePullStatus status = parser.next(value);
+        if (kPullValue == status)
+        {
+            sink(value);
+        }
+        else if (kPullNeedInput == status)
+        {
+            const long count = co_await ReadChunk(loop, source, &buffer[0], buffer.size());
+            if (count > 0)
+                parser.feed(&buffer[0], (size_t)count);
+            else if (count != ByteSource::kWouldBlock)
+                parser.finish();
+        }
+        else if (kPullEnd == status)
+        {
+            co_return;
+        }
+    }
+}
+
+#endif // __linux__
+
+} // end of fnr
+
+#endif // FNR_HAS_COROUTINES
+
+#endif // FAST_NUMBER_READER__ASYNCPARSE_H
@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/ByteSource.h"
+#else
+#   include "ByteSource.h"
+#endif
+
+#include <errno.h>
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+FileSource::FileSource(int fd, bool nonBlocking) : fd_(fd)
+{
+#ifndef _WIN32
+    if (nonBlocking)
+    {
+        const int flags = fcntl(fd, F_GETFL);
+        if (flags != -1)
+            fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+#else
+    (void)nonBlocking;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+long FileSource::read(CharType* buffer, size_t capacity)
+{
+    for (;;)
+    {
+#ifdef _WIN32
+        const long count = _read(fd_, buffer, (unsigned int)capacity);
+#else
+        const long count = (long)::read(fd_, buffer, capacity);
+#endif
+        if (count >= 0)
+            return count;
+
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return kWouldBlock;
+        return kError;
+    }
+}
+
+} // end of fnr
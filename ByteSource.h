@@ -0,0 +1,80 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__BYTESOURCE_H
+#define FAST_NUMBER_READER__BYTESOURCE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stddef.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Where stream parsers get their chunks from.
+class ByteSource
+{
+public:
+    enum
+    {
+        kEnd = 0,
+        kWouldBlock = -1,
+        kError = -2
+    };
+
+    virtual ~ByteSource() {}
+
+    // Copies up to capacity bytes to buffer and returns their count, or
+    // kEnd, kError, or kWouldBlock if a non-blocking source has no data yet.
+    virtual long read(CharType* buffer, size_t capacity) = 0;
+
+    // Descriptor to wait on after kWouldBlock, -1 if there is none.
+    virtual int descriptor() const { return -1; }
+};
+
+//-----------------------------------------------------------------------------
+// File, pipe or socket descriptor. The descriptor is not closed here.
+class FileSource : public ByteSource
+{
+public:
+    explicit FileSource(int fd, bool nonBlocking = false);
+
+    long read(CharType* buffer, size_t capacity);
+    int descriptor() const { return fd_; }
+
+private:
+
+    int fd_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__BYTESOURCE_H
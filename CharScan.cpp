@@ -0,0 +1,217 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "CharScan.h"
+#endif
+
+#if (FNR_SSE2==1)
+#   include <emmintrin.h>
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+static bool IsNumberStart(CharType ch)
+{
+    return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.';
+}
+
+#if (FNR_SSE2==1)
+//-----------------------------------------------------------------------------
+static __m128i SpaceMask(__m128i chunk)
+{
+    __m128i mask = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\v')));
+    return mask;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+DelimiterSet::DelimiterSet(const CharType* delimiters) : count_(0)
+{
+    for (int i = 0; delimiters && delimiters[i] && count_ < kMaxDelimiters; ++i)
+    {
+        if (!contains(delimiters[i]))
+            chars_[count_++] = delimiters[i];
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool DelimiterSet::contains(CharType ch) const
+{
+    for (int i = 0; i < count_; ++i)
+    {
+        if (ch == chars_[i]) return true;
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+const CharType* SkipSpaces(const CharType* begin, const CharType* end)
+{
+#if (FNR_SSE2==1)
+    while (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)begin);
+        int bits = ~_mm_movemask_epi8(SpaceMask(chunk)) & 0xFFFF;
+        if (bits)
+            return begin + LowestBitIndex(bits);
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && IsSpaceChar(*begin))
+        ++begin;
+    return begin;
+}
+
+//-----------------------------------------------------------------------------
+const CharType* SkipDelimiters(const CharType* begin, const CharType* end,
+                               const DelimiterSet& delimiters)
+{
+#if (FNR_SSE2==1)
+    __m128i sets[DelimiterSet::kMaxDelimiters];
+    const int count = delimiters.count();
+    for (int i = 0; i < count; ++i)
+        sets[i] = _mm_set1_epi8(delimiters.at(i));
+
+    while (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)begin);
+        __m128i mask = SpaceMask(chunk);
+        for (int i = 0; i < count; ++i)
+            mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, sets[i]));
+
+        int bits = ~_mm_movemask_epi8(mask) & 0xFFFF;
+        if (bits)
+            return begin + LowestBitIndex(bits);
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && (IsSpaceChar(*begin) || delimiters.contains(*begin)))
+        ++begin;
+    return begin;
+}
+
+//-----------------------------------------------------------------------------
+const CharType* FindDelimiter(const CharType* begin, const CharType* end,
+                              const DelimiterSet& delimiters)
+{
+#if (FNR_SSE2==1)
+    __m128i sets[DelimiterSet::kMaxDelimiters];
+    const int count = delimiters.count();
+    for (int i = 0; i < count; ++i)
+        sets[i] = _mm_set1_epi8(delimiters.at(i));
+
+    while (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)begin);
+        __m128i mask = _mm_setzero_si128();
+        for (int i = 0; i < count; ++i)
+            mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, sets[i]));
+
+        int bits = _mm_movemask_epi8(mask);
+        if (bits)
+            return begin + LowestBitIndex(bits);
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && !delimiters.contains(*begin))
+        ++begin;
+    return begin;
+}
+
+//-----------------------------------------------------------------------------
+const CharType* FindSeparator(const CharType* begin, const CharType* end,
+                              const DelimiterSet& delimiters)
+{
+#if (FNR_SSE2==1)
+    __m128i sets[DelimiterSet::kMaxDelimiters];
+    const int count = delimiters.count();
+    for (int i = 0; i < count; ++i)
+        sets[i] = _mm_set1_epi8(delimiters.at(i));
+
+    while (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)begin);
+        __m128i mask = SpaceMask(chunk);
+        for (int i = 0; i < count; ++i)
+            mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, sets[i]));
+
+        int bits = _mm_movemask_epi8(mask);
+        if (bits)
+            return begin + LowestBitIndex(bits);
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && !IsSpaceChar(*begin) && !delimiters.contains(*begin))
+        ++begin;
+    return begin;
+}
+
+//-----------------------------------------------------------------------------
+const CharType* FindNumberStart(const CharType* begin, const CharType* end)
+{
+#if (FNR_SSE2==1)
+    const __m128i zero  = _mm_set1_epi8('0');
+    const __m128i nine  = _mm_set1_epi8(9);
+    const __m128i minus = _mm_set1_epi8('-');
+    const __m128i plus  = _mm_set1_epi8('+');
+    const __m128i point = _mm_set1_epi8('.');
+
+    while (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)begin);
+
+        // ch - '0' as unsigned byte is at most 9 only for digits
+        __m128i d = _mm_sub_epi8(chunk, zero);
+        __m128i mask = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, minus));
+        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, plus));
+        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, point));
+
+        int bits = _mm_movemask_epi8(mask);
+        if (bits)
+            return begin + LowestBitIndex(bits);
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && !IsNumberStart(*begin))
+        ++begin;
+    return begin;
+}
+
+} // end of fnr
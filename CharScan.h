@@ -0,0 +1,162 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__CHARSCAN_H
+#define FAST_NUMBER_READER__CHARSCAN_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stdint.h>
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Index of the lowest set bit, bits must not be 0.
+inline int LowestBitIndex(unsigned int bits)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+inline int LowestBitIndex64(uint64_t bits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#elif defined(_MSC_VER)
+    return (uint32_t)bits ? LowestBitIndex((uint32_t)bits) : 32 + LowestBitIndex((uint32_t)(bits >> 32));
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Index of the highest set bit, bits must not be 0.
+inline int HighestBitIndex64(uint64_t bits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, bits);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (bits >> 32)
+    {
+        _BitScanReverse(&index, (unsigned long)(bits >> 32));
+        return 32 + (int)index;
+    }
+    _BitScanReverse(&index, (unsigned long)bits);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(bits);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+inline int BitCount64(uint64_t bits)
+{
+#if defined(_MSC_VER) || !defined(__GNUC__)
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((bits * 0x0101010101010101ULL) >> 56);
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+inline bool IsSpaceChar(CharType ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v';
+}
+
+//-----------------------------------------------------------------------------
+// Chars that separate fields besides whitespace, e.g. ",;|".
+class DelimiterSet
+{
+public:
+    enum { kMaxDelimiters = 8 };
+
+    DelimiterSet(const CharType* delimiters = "");
+
+    bool contains(CharType ch) const;
+    int count() const { return count_; }
+    CharType at(int i) const { return chars_[i]; }
+
+private:
+
+    CharType chars_[kMaxDelimiters];
+    int count_;
+
+};
+
+//-----------------------------------------------------------------------------
+// Returns the first char in [begin, end) that is not a space, tab, CR, LF or
+// VT, or end if there is none.
+const CharType* SkipSpaces(const CharType* begin, const CharType* end);
+
+//-----------------------------------------------------------------------------
+// Same as SkipSpaces() but skips the chars of delimiters as well.
+const CharType* SkipDelimiters(const CharType* begin, const CharType* end,
+                               const DelimiterSet& delimiters);
+
+//-----------------------------------------------------------------------------
+// Returns the first char in [begin, end) that is one of delimiters, or end if
+// there is none. Spaces are not special here.
+const CharType* FindDelimiter(const CharType* begin, const CharType* end,
+                              const DelimiterSet& delimiters);
+
+//-----------------------------------------------------------------------------
+// Returns the first char in [begin, end) that is whitespace or one of
+// delimiters, or end if there is none: the end of the token at begin.
+const CharType* FindSeparator(const CharType* begin, const CharType* end,
+                              const DelimiterSet& delimiters);
+
+//-----------------------------------------------------------------------------
+// Returns the first char in [begin, end) that can start a number (a digit,
+// a sign or a point), or end if there is none.
+//
+// The scan functions check 16 chars per step when FNR_SSE2 is on.
+const CharType* FindNumberStart(const CharType* begin, const CharType* end);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__CHARSCAN_H
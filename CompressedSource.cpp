@@ -0,0 +1,241 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CompressedSource.h"
+#else
+#   include "CompressedSource.h"
+#endif
+
+#include <string.h>
+#if (FNR_HAS_ZLIB==1)
+#   include <zlib.h>
+#endif
+#if (FNR_HAS_ZSTD==1)
+#   include <zstd.h>
+#endif
+
+namespace fnr
+{
+
+// largest window handed to a decoder in one call, zlib counts in uInt
+static const size_t kMaxWindow = 1 << 30;
+
+#if (FNR_HAS_ZLIB==1)
+//-----------------------------------------------------------------------------
+struct GzipSource::State
+{
+    z_stream stream;
+    bool ready;         // inflateInit2 succeeded
+    bool inputEnd;      // the compressed source is used up
+    bool midStream;     // a member was started and has not ended
+    bool failed;        // kError is due
+};
+
+//-----------------------------------------------------------------------------
+GzipSource::GzipSource(ByteSource& compressed, size_t inputSize)
+  : compressed_(compressed),
+    input_(inputSize ? inputSize : 1),
+    state_(new State)
+{
+    memset(state_, 0, sizeof(State));
+    // 32 lets zlib tell a gzip from a zlib header
+    state_->ready = (inflateInit2(&state_->stream, 15 + 32) == Z_OK);
+}
+
+//-----------------------------------------------------------------------------
+GzipSource::~GzipSource()
+{
+    if (state_->ready)
+        inflateEnd(&state_->stream);
+    delete state_;
+}
+
+//-----------------------------------------------------------------------------
+long GzipSource::read(CharType* buffer, size_t capacity)
+{
+    State& s = *state_;
+    if (!s.ready || s.failed)
+        return kError;
+    if (capacity > kMaxWindow)
+        capacity = kMaxWindow;
+
+    z_stream& z = s.stream;
+    z.next_out = (Bytef*)buffer;
+    z.avail_out = (uInt)capacity;
+    for (;;)
+    {
+        // output may be pending in zlib without new input, so inflate first
+        const uInt inBefore = z.avail_in;
+        const uInt outBefore = z.avail_out;
+        const int result = inflate(&z, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+        {
+            inflateReset(&z);   // a further gzip member may follow
+            s.midStream = false;
+        }
+        else if (result == Z_OK)
+        {
+            s.midStream = true;
+        }
+        else if (result != Z_BUF_ERROR)
+        {
+            s.failed = true;
+            break;
+        }
+
+        if (z.avail_out == 0)
+            return (long)capacity;
+        if (result == Z_STREAM_END || z.avail_in != inBefore || z.avail_out != outBefore)
+            continue;
+
+        // stuck for lack of input
+        if (s.inputEnd)
+        {
+            s.failed = s.midStream;     // truncated
+            break;
+        }
+        const long count = compressed_.read((CharType*)&input_[0], input_.size());
+        if (count > 0)
+        {
+            z.next_in = &input_[0];
+            z.avail_in = (uInt)count;
+        }
+        else if (count == kEnd)
+        {
+            s.inputEnd = true;
+        }
+        else
+        {
+            s.failed = (count == kError);
+            const long produced = (long)(capacity - z.avail_out);
+            return produced ? produced : count;
+        }
+    }
+
+    const long produced = (long)(capacity - z.avail_out);
+    if (produced)
+        return produced;    // an error is reported on the next call
+    return s.failed ? kError : kEnd;
+}
+#endif
+
+#if (FNR_HAS_ZSTD==1)
+//-----------------------------------------------------------------------------
+struct ZstdSource::State
+{
+    ZSTD_DStream* stream;
+    ZSTD_inBuffer in;
+    bool inputEnd;      // the compressed source is used up
+    bool midFrame;      // a frame was started and has not ended
+    bool failed;        // kError is due
+};
+
+//-----------------------------------------------------------------------------
+ZstdSource::ZstdSource(ByteSource& compressed, size_t inputSize)
+  : compressed_(compressed),
+    input_(inputSize ? inputSize : 1),
+    state_(new State)
+{
+    memset(state_, 0, sizeof(State));
+    state_->stream = ZSTD_createDStream();
+    if (state_->stream && ZSTD_isError(ZSTD_initDStream(state_->stream)))
+    {
+        ZSTD_freeDStream(state_->stream);
+        state_->stream = 0;
+    }
+    state_->in.src = &input_[0];
+}
+
+//-----------------------------------------------------------------------------
+ZstdSource::~ZstdSource()
+{
+    if (state_->stream)
+        ZSTD_freeDStream(state_->stream);
+    delete state_;
+}
+
+//-----------------------------------------------------------------------------
+long ZstdSource::read(CharType* buffer, size_t capacity)
+{
+    State& s = *state_;
+    if (!s.stream || s.failed)
+        return kError;
+    if (capacity > kMaxWindow)
+        capacity = kMaxWindow;
+
+    ZSTD_inBuffer& in = s.in;
+    ZSTD_outBuffer out = { buffer, capacity, 0 };
+    for (;;)
+    {
+        // the decoder may hold output without new input, so decode first
+        const size_t inBefore = in.pos;
+        const size_t outBefore = out.pos;
+        const size_t result = ZSTD_decompressStream(s.stream, &out, &in);
+        if (ZSTD_isError(result))
+        {
+            s.failed = true;
+            break;
+        }
+
+        const bool progress = (in.pos != inBefore || out.pos != outBefore);
+        if (progress)
+            s.midFrame = (result != 0);     // 0 ends a frame, more may follow
+        if (out.pos == out.size)
+            return (long)capacity;
+        if (progress)
+            continue;
+
+        // stuck for lack of input
+        if (s.inputEnd)
+        {
+            s.failed = s.midFrame;      // truncated
+            break;
+        }
+        const long count = compressed_.read((CharType*)&input_[0], input_.size());
+        if (count > 0)
+        {
+            in.src = &input_[0];
+            in.size = (size_t)count;
+            in.pos = 0;
+        }
+        else if (count == kEnd)
+        {
+            s.inputEnd = true;
+        }
+        else
+        {
+            s.failed = (count == kError);
+            return out.pos ? (long)out.pos : count;
+        }
+    }
+
+    if (out.pos)
+        return (long)out.pos;   // an error is reported on the next call
+    return s.failed ? kError : kEnd;
+}
+#endif
+
+} // end of fnr
@@ -0,0 +1,99 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__COMPRESSEDSOURCE_H
+#define FAST_NUMBER_READER__COMPRESSEDSOURCE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/ByteSource.h"
+#else
+#   include "ByteSource.h"
+#endif
+
+#include <stddef.h>
+#include <vector>
+
+namespace fnr
+{
+
+#if (FNR_HAS_ZLIB==1)
+//-----------------------------------------------------------------------------
+// Inflates gzip or zlib data read from another source, concatenated gzip
+// members included. read() inflates straight into the caller's buffer, so
+// a stream parser fed from it parses every window in place and only the
+// compressed input is buffered here. Corrupt or truncated data gives
+// kError.
+class GzipSource : public ByteSource
+{
+public:
+    explicit GzipSource(ByteSource& compressed, size_t inputSize = 1 << 16);
+    ~GzipSource();
+
+    long read(CharType* buffer, size_t capacity);
+    int descriptor() const { return compressed_.descriptor(); }
+
+private:
+
+    GzipSource(const GzipSource&);
+    GzipSource& operator=(const GzipSource&);
+
+    struct State;
+
+    ByteSource& compressed_;
+    std::vector<ByteType> input_;
+    State* state_;
+
+};
+#endif
+
+#if (FNR_HAS_ZSTD==1)
+//-----------------------------------------------------------------------------
+// The same for zstd data, concatenated frames included.
+class ZstdSource : public ByteSource
+{
+public:
+    explicit ZstdSource(ByteSource& compressed, size_t inputSize = 1 << 17);
+    ~ZstdSource();
+
+    long read(CharType* buffer, size_t capacity);
+    int descriptor() const { return compressed_.descriptor(); }
+
+private:
+
+    ZstdSource(const ZstdSource&);
+    ZstdSource& operator=(const ZstdSource&);
+
+    struct State;
+
+    ByteSource& compressed_;
+    std::vector<ByteType> input_;
+    State* state_;
+
+};
+#endif
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__COMPRESSEDSOURCE_H
@@ -32,6 +32,71 @@ typedef unsigned char ByteType;
 // use 0 or 1
 #define FNR_GETCHARCLASS 0
 
+// use 0 or 1 (1 enables SSE2 kernels if the compiler targets SSE2)
+#define FNR_SIMD 1
+
+#if (FNR_SIMD==1) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#   define FNR_SSE2 1
+#else
+#   define FNR_SSE2 0
+#endif
+
+// use 0 or 1 (1 gives every thread its own reader state, needs C++11)
+#define FNR_THREAD_SAFE 1
+
+#if (FNR_THREAD_SAFE==1)
+#   define FNR_THREAD_LOCAL thread_local
+#else
+#   define FNR_THREAD_LOCAL
+#endif
+
+// use 0 or 1 (1 enables the coroutine front end of AsyncParse.h, needs C++20)
+#define FNR_COROUTINES 1
+
+#if (FNR_COROUTINES==1) && defined(__cpp_impl_coroutine)
+#   define FNR_HAS_COROUTINES 1
+#else
+#   define FNR_HAS_COROUTINES 0
+#endif
+
+// use 0 or 1 (1 lets FileIngest queue its reads with io_uring on Linux,
+// it falls back to pread at run time if the kernel refuses the ring)
+#define FNR_IO_URING 1
+
+#if (FNR_IO_URING==1) && defined(__linux__) && defined(__has_include)
+#   if __has_include(<linux/io_uring.h>)
+#       define FNR_HAS_IO_URING 1
+#   endif
+#endif
+#ifndef FNR_HAS_IO_URING
+#   define FNR_HAS_IO_URING 0
+#endif
+
+// use 0 or 1 (1 adds GzipSource if zlib.h is found, link with -lz)
+#define FNR_ZLIB 1
+
+#if (FNR_ZLIB==1) && defined(__has_include)
+#   if __has_include(<zlib.h>)
+#       define FNR_HAS_ZLIB 1
+#   endif
+#endif
+#ifndef FNR_HAS_ZLIB
+#   define FNR_HAS_ZLIB 0
+#endif
+
+// use 0 or 1 (1 adds ZstdSource if zstd.h is found, link with -lzstd, the
+// project files link zlib only)
+#define FNR_ZSTD 0
+
+#if (FNR_ZSTD==1) && defined(__has_include)
+#   if __has_include(<zstd.h>)
+#       define FNR_HAS_ZSTD 1
+#   endif
+#endif
+#ifndef FNR_HAS_ZSTD
+#   define FNR_HAS_ZSTD 0
+#endif
+
 } // end of fnr
 
 #endif // FAST_NUMBER_READER_CONFIG_H
@@ -0,0 +1,220 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CsvReader.h"
+#else
+#   include "CsvReader.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+static const CharType* SkipBlanks(const CharType* p, const CharType* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+//-----------------------------------------------------------------------------
+CsvReader::CsvReader(const eColumnType* schema, int columnCount, CharType separator) :
+    columns_(columnCount),
+    separator_(separator),
+    skipHeader_(false),
+    rowCount_(0)
+{
+    const CharType fieldEnds[] = { separator, '\n', '\r', 0 };
+    fieldEnds_ = DelimiterSet(fieldEnds);
+
+    for (int i = 0; i < columnCount; ++i)
+        columns_[i].type = schema[i];
+}
+
+//-----------------------------------------------------------------------------
+void CsvReader::clear()
+{
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+        Column& column = columns_[i];
+        column.longs.clear();
+        column.ints.clear();
+        column.shorts.clear();
+        column.doubles.clear();
+        column.floats.clear();
+        column.longDoubles.clear();
+    }
+    rowCount_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+void CsvReader::read(const CharType* text, size_t length)
+{
+    const CharType* p = text;
+    const CharType* end = text + length;
+    const DelimiterSet lineEnds("\n\r");
+
+    if (skipHeader_)
+    {
+        p = FindDelimiter(p, end, lineEnds);
+    }
+
+    while (p < end)
+    {
+        if (*p == '\n' || *p == '\r')
+        {
+            ++p;
+            continue;
+        }
+
+        bool lineEnded = false;
+        for (size_t i = 0; i < columns_.size(); ++i)
+        {
+            if (lineEnded)
+            {
+                AddNull(columns_[i]);
+                continue;
+            }
+
+            p = ReadField(columns_[i], p, end);
+            if (p < end && *p == separator_)
+                ++p;
+            else
+                lineEnded = true;
+        }
+
+        if (!lineEnded)
+            p = FindDelimiter(p, end, lineEnds);
+        if (p < end && *p == '\r')
+            ++p;
+        if (p < end && *p == '\n')
+            ++p;
+        ++rowCount_;
+    }
+}
+
+//-----------------------------------------------------------------------------
+const CharType* CsvReader::ReadField(Column& column, const CharType* p, const CharType* end)
+{
+    if (column.type == kColumnSkip)
+        return SkipField(p, end);
+
+    const CharType* field = p;
+    p = SkipBlanks(p, end);
+    const bool quoted = p < end && *p == '"';
+    p = SkipBlanks(p + quoted, end);
+
+    size_t length = 0;
+    if (p < end && !fieldEnds_.contains(*p) && *p != '"')
+        length = ReadNumber(column, p, end);
+
+    p = SkipBlanks(p + length, end);
+    if (quoted)
+    {
+        if (p < end && *p == '"')
+            p = SkipBlanks(p + 1, end);
+        else
+            length = 0;
+    }
+
+    if (p < end && !fieldEnds_.contains(*p))
+    {
+        AddNull(column);
+        return SkipField(field, end);
+    }
+
+    if (!length)
+    {
+        AddNull(column);
+        return p;
+    }
+
+    switch (column.type)
+    {
+        case kColumnLong:       column.longs.append(longReader_.value());  break;
+        case kColumnInt:        column.ints.append(intReader_.value());  break;
+        case kColumnShort:      column.shorts.append(shortReader_.value());  break;
+        case kColumnDouble:     column.doubles.append(doubleReader_.value());  break;
+        case kColumnFloat:      column.floats.append(floatReader_.value());  break;
+        case kColumnLongDouble: column.longDoubles.append(longDoubleReader_.value());  break;
+        default: break;
+    }
+    return p;
+}
+
+//-----------------------------------------------------------------------------
+const CharType* CsvReader::SkipField(const CharType* p, const CharType* end)
+{
+    p = SkipBlanks(p, end);
+    if (p < end && *p == '"')
+    {
+        // "" inside a quoted field is an escaped quote
+        for (++p; p < end; ++p)
+        {
+            if (*p == '"')
+            {
+                if (p + 1 < end && p[1] == '"')
+                    ++p;
+                else
+                    break;
+            }
+        }
+    }
+    return FindDelimiter(p, end, fieldEnds_);
+}
+
+//-----------------------------------------------------------------------------
+size_t CsvReader::ReadNumber(Column& column, const CharType* p, const CharType* end)
+{
+    switch (column.type)
+    {
+        case kColumnLong:       return longReader_.read(p, end - p);
+        case kColumnInt:        return intReader_.read(p, end - p);
+        case kColumnShort:      return shortReader_.read(p, end - p);
+        case kColumnDouble:     return doubleReader_.readWithIntegers(p, end - p);
+        case kColumnFloat:      return floatReader_.readWithIntegers(p, end - p);
+        case kColumnLongDouble: return longDoubleReader_.readWithIntegers(p, end - p);
+        default: break;
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+void CsvReader::AddNull(Column& column)
+{
+    switch (column.type)
+    {
+        case kColumnLong:       column.longs.appendNull();  break;
+        case kColumnInt:        column.ints.appendNull();  break;
+        case kColumnShort:      column.shorts.appendNull();  break;
+        case kColumnDouble:     column.doubles.appendNull();  break;
+        case kColumnFloat:      column.floats.appendNull();  break;
+        case kColumnLongDouble: column.longDoubles.appendNull();  break;
+        default: break;
+    }
+}
+
+} // end of fnr
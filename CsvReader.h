@@ -0,0 +1,114 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__CSVREADER_H
+#define FAST_NUMBER_READER__CSVREADER_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberColumn.h"
+#else
+#   include "NumberColumn.h"
+#endif
+
+namespace fnr
+{
+
+enum eColumnType
+{
+    kColumnSkip,
+    kColumnLong,
+    kColumnInt,
+    kColumnShort,
+    kColumnDouble,
+    kColumnFloat,
+    kColumnLongDouble
+};
+
+//-----------------------------------------------------------------------------
+// Reads CSV rows straight into one typed column per schema entry. Every
+// field is converted by the NumberReader of its column type right in the
+// input buffer, there is no separate tokenizing pass. Floating point
+// columns take whole numbers ("100") as well. Quoted fields are unquoted,
+// empty, malformed or out of range fields become nulls, fields past the
+// schema are ignored and missing ones are treated as empty.
+class CsvReader
+{
+public:
+    CsvReader(const eColumnType* schema, int columnCount, CharType separator = ',');
+
+    void setSkipHeader(bool skip) { skipHeader_ = skip; }
+
+    // Reads all rows of text, the last one may have no line end.
+    void read(const CharType* text, size_t length);
+    void clear();
+
+    int columnCount() const { return (int)columns_.size(); }
+    eColumnType columnType(int column) const { return columns_[column].type; }
+    size_t rowCount() const { return rowCount_; }
+
+    const NumberColumn<long>& longs(int column) const { return columns_[column].longs; }
+    const NumberColumn<int>& ints(int column) const { return columns_[column].ints; }
+    const NumberColumn<short>& shorts(int column) const { return columns_[column].shorts; }
+    const NumberColumn<double>& doubles(int column) const { return columns_[column].doubles; }
+    const NumberColumn<float>& floats(int column) const { return columns_[column].floats; }
+    const NumberColumn<long double>& longDoubles(int column) const { return columns_[column].longDoubles; }
+
+private:
+
+    struct Column
+    {
+        eColumnType type;
+
+        NumberColumn<long> longs;
+        NumberColumn<int> ints;
+        NumberColumn<short> shorts;
+        NumberColumn<double> doubles;
+        NumberColumn<float> floats;
+        NumberColumn<long double> longDoubles;
+    };
+
+    const CharType* ReadField(Column& column, const CharType* p, const CharType* end);
+    const CharType* SkipField(const CharType* p, const CharType* end);
+    size_t ReadNumber(Column& column, const CharType* p, const CharType* end);
+    void AddNull(Column& column);
+
+    std::vector<Column> columns_;
+    CharType separator_;
+    DelimiterSet fieldEnds_;
+    bool skipHeader_;
+    size_t rowCount_;
+
+    NumberReader<long> longReader_;
+    NumberReader<int> intReader_;
+    NumberReader<short> shortReader_;
+    NumberReader<double> doubleReader_;
+    NumberReader<float> floatReader_;
+    NumberReader<long double> longDoubleReader_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__CSVREADER_H
@@ -0,0 +1,479 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/DecimalConvert.h"
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "DecimalConvert.h"
+#   include "CharScan.h"
+#endif
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace fnr
+{
+
+// every power here is exact in its type
+static const float kFloatPow10[] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+static const double kDoublePow10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// exact up to 10^27 if long double has a 64-bit mantissa or more
+static const long double kLongDoublePow10[] =
+{
+    1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L,
+    1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L,
+    1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+
+static const int kMaxLongDoublePow10 = (LDBL_MANT_DIG >= 64) ? 27 : 22;
+
+static const int kMaxFloatPow10 = 10;
+static const int kMaxDoublePow10 = 22;
+
+// 5^(28 i) for i = kPow5StepMin .. 11, rounded to 64 bits with the top bit
+// set: 5^(28 i) ~ kPow5Step[k] * 2^kPow5StepExp2[k], k = i - kPow5StepMin.
+// Times the exact 5^j, j < 28, they give every power of 5 a double needs.
+static const int kPow5StepMin = -13;
+static const int kPow5StepLength = 28;
+
+static const uint64_t kPow5Step[] =
+{
+    0xE1AFA13AFBD14D6EULL, 0xE3E27A444D8D98B8ULL, 0xE61ACF033D1A45DFULL,
+    0xE858AD248F5C22CAULL, 0xEA9C227723EE8BCBULL, 0xECE53CEC4A314EBEULL,
+    0xEF340A98172AACE5ULL, 0xF18899B1BC3F8CA2ULL, 0xF3E2F893DEC3F126ULL,
+    0xF64335BCF065D37DULL, 0xF8A95FCF88747D94ULL, 0xFB158592BE068D2FULL,
+    0xFD87B5F28300CA0EULL, 0x8000000000000000ULL, 0x813F3978F8940984ULL,
+    0x82818F1281ED44A0ULL, 0x83C7088E1AAB65DBULL, 0x850FADC09923329EULL,
+    0x865B86925B9BC5C2ULL, 0x87AA9AFF79042287ULL, 0x88FCF317F22241E2ULL,
+    0x8A5296FFE33CC930ULL, 0x8BAB8EEFB6409C1AULL, 0x8D07E33455637EB3ULL,
+    0x8E679C2F5E44FF8FULL
+};
+
+static const int kPow5StepExp2[] =
+{
+    -909, -844, -779, -714, -649, -584, -519, -454, -389, -324, -259, -194,
+    -129, -63, 2, 67, 132, 197, 262, 327, 392, 457, 522, 587, 652
+};
+
+static const uint64_t kPow5[] =
+{
+    1ULL, 5ULL, 25ULL, 125ULL, 625ULL, 3125ULL, 15625ULL, 78125ULL, 390625ULL,
+    1953125ULL, 9765625ULL, 48828125ULL, 244140625ULL, 1220703125ULL,
+    6103515625ULL, 30517578125ULL, 152587890625ULL, 762939453125ULL,
+    3814697265625ULL, 19073486328125ULL, 95367431640625ULL, 476837158203125ULL,
+    2384185791015625ULL, 11920928955078125ULL, 59604644775390625ULL,
+    298023223876953125ULL, 1490116119384765625ULL, 7450580596923828125ULL
+};
+
+//-----------------------------------------------------------------------------
+// Prints d so that strtod() & co. round it the same way as the exact value:
+// a dropped tail is represented by a trailing 1 digit.
+static void FormatDecimal(const Decimal& d, char* buffer, size_t size)
+{
+    char tail[24] = "";
+    if (d.tailDigits)
+        snprintf(tail, sizeof(tail), "%0*llu", d.tailDigits, (unsigned long long)d.tail);
+
+    snprintf(buffer, size, "%s%llu%s%se%d",
+             d.negative ? "-" : "",
+             (unsigned long long)d.mantissa,
+             tail,
+             d.truncated ? "1" : "",
+             d.truncated ? d.exp10 - 1 : d.exp10);
+}
+
+//-----------------------------------------------------------------------------
+// Low bits of a wider mantissa that the target type drops; the rounding
+// is safe to do in one step if they are not within margin of the halfway.
+static bool IsNearHalfway(uint64_t droppedBits, int droppedCount, uint64_t margin)
+{
+    const uint64_t half = 1ULL << (droppedCount - 1);
+    const uint64_t low = droppedBits & ((half << 1) - 1);
+    return (low > half ? low - half : half - low) <= margin;
+}
+
+//-----------------------------------------------------------------------------
+static bool IsShort(const Decimal& d)
+{
+    return !d.tailDigits && !d.truncated;
+}
+
+//-----------------------------------------------------------------------------
+// 64 x 64 -> 128 bit product, returns the high half and sets low.
+static inline uint64_t MultiplyHigh(uint64_t a, uint64_t b, uint64_t& low)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = (unsigned __int128)a * b;
+    low = (uint64_t)product;
+    return (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    low = _umul128(a, b, &high);
+    return high;
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    low = a * b;
+    return __umulh(a, b);
+#else
+    const uint64_t aLo = (uint32_t)a, aHi = a >> 32;
+    const uint64_t bLo = (uint32_t)b, bHi = b >> 32;
+    const uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    const uint64_t middle = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+    low = (middle << 32) | (uint32_t)ll;
+    return hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Normalizes the top half of a product of two normalized numbers: its top
+// bit is set unless it moves in the first bit of the low half.
+static inline uint64_t Normalize(uint64_t high, uint64_t low, int& exp2)
+{
+    if (high >> 63)
+        return high;
+    --exp2;
+    return (high << 1) | (low >> 63);
+}
+
+//-----------------------------------------------------------------------------
+// digits * 10^exp10 rounded to double by binary scaling, in the style of
+// Eisel and Lemire: 10^q = 5^q * 2^q, and 5^q is a 64-bit mantissa from the
+// tables. digits are the exact value less at most one if inexact. The top
+// 64 bits of the product are then off by a few units of their last bit,
+// and rounding them to 53 bits is safe unless IsNearHalfway says so.
+// Returns false for that, and for results out of the normal range.
+static bool ScaleToDouble(uint64_t digits, int exp10, bool inexact, double& value)
+{
+    const int i = (exp10 >= 0 ? exp10 : exp10 - (kPow5StepLength - 1)) / kPow5StepLength;
+    const int j = exp10 - i * kPow5StepLength;
+    uint64_t low;
+
+    // 5^exp10 ~ pow5 * 2^exp2
+    const int shift5 = 63 - HighestBitIndex64(kPow5[j]);
+    int exp2 = kPow5StepExp2[i - kPow5StepMin] + 64 - shift5;
+    uint64_t pow5 = MultiplyHigh(kPow5Step[i - kPow5StepMin], kPow5[j] << shift5, low);
+    pow5 = Normalize(pow5, low, exp2);
+
+    // digits * 10^exp10 ~ bits * 2^exp2. In units of 2^-64 of the value,
+    // pow5 is within 6 (a rounded table entry, the cut product and its
+    // normalizing shift) and bits within 8; inexact digits have 19 places,
+    // their error of one adds less than 2^64 / 10^18 < 19.
+    const int shift = 63 - HighestBitIndex64(digits);
+    exp2 += exp10 + 64 - shift;
+    uint64_t bits = MultiplyHigh(digits << shift, pow5, low);
+    bits = Normalize(bits, low, exp2);
+
+    if (IsNearHalfway(bits, 64 - 53, inexact ? 30 : 10))
+        return false;
+
+    uint64_t mantissa = (bits >> 11) + ((bits >> 10) & 1);
+    int biased = exp2 + 63 + 1023;
+    if (mantissa >> 53)
+    {
+        mantissa >>= 1;
+        ++biased;
+    }
+    if (biased < 1 || biased > 2046)
+        return false;
+
+    const uint64_t result = ((uint64_t)biased << 52) | (mantissa & ((1ULL << 52) - 1));
+    memcpy(&value, &result, sizeof(value));
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+float DecimalToFloat(const Decimal& d)
+{
+    // exponent of the mantissa digits, their value is 1 .. 10^19
+    const int leadExp10 = d.exp10 + d.tailDigits;
+    float value;
+
+    if (!d.mantissa)
+    {
+        value = 0.0f;
+    }
+    else if (IsShort(d) && d.mantissa <= (1ULL << 24) &&
+             d.exp10 >= -kMaxFloatPow10 && d.exp10 <= kMaxFloatPow10)
+    {
+        value = (float)d.mantissa;
+        value = (d.exp10 < 0) ? value / kFloatPow10[-d.exp10] : value * kFloatPow10[d.exp10];
+    }
+    else if (IsShort(d) && d.mantissa <= (1ULL << 53) &&
+             d.exp10 >= 0 && d.exp10 <= kMaxDoublePow10 &&
+             (double)d.mantissa * kDoublePow10[d.exp10] < 9007199254740992.0)
+    {
+        // an integer below 2^53 is exact in double, so narrowing rounds
+        // only once; a quotient or a wider product is rounded twice and
+        // goes through the halfway check below
+        value = (float)((double)d.mantissa * kDoublePow10[d.exp10]);
+    }
+    else if (leadExp10 > 38)
+    {
+        value = HUGE_VALF;
+    }
+    else if (leadExp10 < -46 - 20)
+    {
+        value = 0.0f;
+    }
+    else
+    {
+        // double keeps 29 spare bits, each rounding costs half an ulp of them
+        double digits = (double)d.mantissa;
+        int roundings = 1;
+        if (d.tailDigits)
+        {
+            digits = digits * kDoublePow10[d.tailDigits] + (double)d.tail;
+            roundings += 2;
+        }
+
+        const int e = d.exp10 < 0 ? -d.exp10 : d.exp10;
+        double scale = kDoublePow10[e % kMaxDoublePow10];
+        for (int k = e / kMaxDoublePow10; k > 0; --k, ++roundings)
+            scale *= kDoublePow10[kMaxDoublePow10];
+
+        const double approx = (d.exp10 < 0) ? digits / scale : digits * scale;
+
+        uint64_t bits;
+        memcpy(&bits, &approx, sizeof(bits));
+        if (approx >= FLT_MIN && !IsNearHalfway(bits, 53 - 24, roundings + 2 + d.truncated))
+        {
+            value = (float)approx;
+        }
+        else
+        {
+            char buffer[64];
+            FormatDecimal(d, buffer, sizeof(buffer));
+            return strtof(buffer, 0);
+        }
+    }
+
+    return d.negative ? -value : value;
+}
+
+//-----------------------------------------------------------------------------
+double DecimalToDouble(const Decimal& d)
+{
+    const int leadExp10 = d.exp10 + d.tailDigits;
+    double value;
+
+    if (!d.mantissa)
+    {
+        value = 0.0;
+    }
+    else if (IsShort(d) && d.mantissa <= (1ULL << 53) &&
+             d.exp10 >= -kMaxDoublePow10 && d.exp10 <= kMaxDoublePow10)
+    {
+        value = (double)d.mantissa;
+        value = (d.exp10 < 0) ? value / kDoublePow10[-d.exp10] : value * kDoublePow10[d.exp10];
+    }
+    else if (leadExp10 > 308)
+    {
+        value = HUGE_VAL;
+    }
+    else if (leadExp10 < -324 - 20)
+    {
+        value = 0.0;
+    }
+    else if (!ScaleToDouble(d.mantissa, leadExp10, !IsShort(d), value))
+    {
+        char buffer[64];
+        FormatDecimal(d, buffer, sizeof(buffer));
+        return strtod(buffer, 0);
+    }
+
+    return d.negative ? -value : value;
+}
+
+//-----------------------------------------------------------------------------
+// Unevaluated sum hi + lo of two long doubles, about twice the precision.
+// The operations are the usual error-free transformations (Dekker, Knuth).
+struct LongDoublePair
+{
+    long double hi;
+    long double lo;
+};
+
+//-----------------------------------------------------------------------------
+static LongDoublePair TwoSum(long double a, long double b)
+{
+    LongDoublePair r;
+    r.hi = a + b;
+    const long double bb = r.hi - a;
+    r.lo = (a - (r.hi - bb)) + (b - bb);
+    return r;
+}
+
+//-----------------------------------------------------------------------------
+static LongDoublePair TwoProduct(long double a, long double b)
+{
+    // splits the mantissa in halves, so that their products are exact
+    static const long double kSplit = ldexpl(1.0L, (LDBL_MANT_DIG + 1) / 2) + 1.0L;
+
+    const long double ta = kSplit * a;
+    const long double aHi = ta - (ta - a);
+    const long double aLo = a - aHi;
+    const long double tb = kSplit * b;
+    const long double bHi = tb - (tb - b);
+    const long double bLo = b - bHi;
+
+    LongDoublePair r;
+    r.hi = a * b;
+    r.lo = ((aHi * bHi - r.hi) + aHi * bLo + aLo * bHi) + aLo * bLo;
+    return r;
+}
+
+//-----------------------------------------------------------------------------
+static LongDoublePair Multiply(const LongDoublePair& x, const LongDoublePair& y)
+{
+    LongDoublePair p = TwoProduct(x.hi, y.hi);
+    p.lo += x.hi * y.lo + x.lo * y.hi;
+    return TwoSum(p.hi, p.lo);
+}
+
+//-----------------------------------------------------------------------------
+static LongDoublePair Subtract(const LongDoublePair& x, const LongDoublePair& y)
+{
+    LongDoublePair s = TwoSum(x.hi, -y.hi);
+    s.lo += x.lo - y.lo;
+    return TwoSum(s.hi, s.lo);
+}
+
+//-----------------------------------------------------------------------------
+static LongDoublePair Divide(const LongDoublePair& x, const LongDoublePair& y)
+{
+    const long double q1 = x.hi / y.hi;
+    LongDoublePair q1Pair = { q1, 0.0L };
+    LongDoublePair r = Subtract(x, Multiply(q1Pair, y));
+
+    const long double q2 = r.hi / y.hi;
+    LongDoublePair q2Pair = { q2, 0.0L };
+    r = Subtract(r, Multiply(q2Pair, y));
+
+    const long double q3 = r.hi / y.hi;
+    LongDoublePair q = TwoSum(q1, q2);
+    q.lo += q3;
+    return TwoSum(q.hi, q.lo);
+}
+
+//-----------------------------------------------------------------------------
+// 10^e as a pair, from the exact powers up to 10^kMaxLongDoublePow10.
+static LongDoublePair Pow10Pair(int e)
+{
+    LongDoublePair result = { kLongDoublePow10[e % kMaxLongDoublePow10], 0.0L };
+    LongDoublePair base = { kLongDoublePow10[kMaxLongDoublePow10], 0.0L };
+    for (int k = e / kMaxLongDoublePow10; k; k >>= 1)
+    {
+        if (k & 1)
+            result = Multiply(result, base);
+        if (k > 1)
+            base = Multiply(base, base);
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+long double DecimalToLongDouble(const Decimal& d)
+{
+#if (LDBL_MANT_DIG == DBL_MANT_DIG)
+    return DecimalToDouble(d);
+#else
+    const int leadExp10 = d.exp10 + d.tailDigits;
+    long double value = 0.0L;
+    bool rounded = true;
+
+    if (!d.mantissa)
+    {
+        value = 0.0L;
+    }
+    else if (IsShort(d) && (LDBL_MANT_DIG >= 64 || d.mantissa <= (1ULL << 53)) &&
+             d.exp10 >= -kMaxLongDoublePow10 && d.exp10 <= kMaxLongDoublePow10)
+    {
+        value = (long double)d.mantissa;
+        value = (d.exp10 < 0) ? value / kLongDoublePow10[-d.exp10] : value * kLongDoublePow10[d.exp10];
+    }
+    else if (leadExp10 > LDBL_MAX_10_EXP)
+    {
+        value = HUGE_VALL;
+    }
+    else if (leadExp10 < LDBL_MIN_10_EXP - LDBL_DIG - 20)
+    {
+        value = 0.0L;
+    }
+    else if (leadExp10 > LDBL_MAX_10_EXP - 40 || d.exp10 < LDBL_MIN_10_EXP + 40)
+    {
+        // the pair arithmetic would overflow on the way
+        rounded = false;
+    }
+    else
+    {
+        // mantissa * 10^tailDigits is exact as a pair, adding the tail
+        // rounds only far below the precision of the pair
+        LongDoublePair digits = { (long double)d.mantissa, 0.0L };
+        if (d.tailDigits)
+        {
+            const LongDoublePair product = TwoProduct(digits.hi, kLongDoublePow10[d.tailDigits]);
+            const LongDoublePair sum = TwoSum(product.hi, (long double)d.tail);
+            digits = TwoSum(sum.hi, sum.lo + product.lo);
+        }
+
+        const LongDoublePair scaled = (d.exp10 < 0) ?
+            Divide(digits, Pow10Pair(-d.exp10)) :
+            Multiply(digits, Pow10Pair(d.exp10));
+
+        // hi is hi + lo rounded to long double; that is the rounding of the
+        // exact value too unless lo is within the pair error of half an ulp
+        int binaryExp;
+        frexpl(scaled.hi, &binaryExp);
+        const long double halfUlp = ldexpl(1.0L, binaryExp - LDBL_MANT_DIG - 1);
+        const long double error = ldexpl(fabsl(scaled.hi), 16 - 2 * LDBL_MANT_DIG);
+
+        value = scaled.hi;
+        rounded = fabsl(scaled.hi) >= LDBL_MIN && halfUlp - fabsl(scaled.lo) > error;
+    }
+
+    if (!rounded)
+    {
+        char buffer[64];
+        FormatDecimal(d, buffer, sizeof(buffer));
+        return strtold(buffer, 0);
+    }
+
+    return d.negative ? -value : value;
+#endif
+}
+
+} // end of fnr
@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__DECIMALCONVERT_H
+#define FAST_NUMBER_READER__DECIMALCONVERT_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stdint.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// A number as the readers collect it: the value is
+// (mantissa * 10^tailDigits + tail) * 10^exp10, where mantissa holds the
+// first 19 significant digits and tail the next 19. truncated is set if a
+// nonzero digit after them was dropped.
+struct Decimal
+{
+    uint64_t mantissa;
+    uint64_t tail;
+    int tailDigits;
+    int exp10;
+    bool negative;
+    bool truncated;
+};
+
+//-----------------------------------------------------------------------------
+// Correctly rounded conversions. Exact cases are computed directly in the
+// target precision (the Clinger fast path), the rest is computed in a wider
+// type (for double a 64x64->128 bit product with a power of five, on every
+// target) and rounded once to the target unless the result falls too close
+// to a rounding boundary, which is resolved by the C library. Digits past
+// the 38th only count as a nonzero tail.
+float DecimalToFloat(const Decimal& d);
+double DecimalToDouble(const Decimal& d);
+
+//-----------------------------------------------------------------------------
+// Same for long double. Beyond the exact fast path it works in pairs of
+// long doubles (twice the mantissa bits), so the x87 80-bit type gets its
+// full 64-bit precision instead of a widened double.
+long double DecimalToLongDouble(const Decimal& d);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__DECIMALCONVERT_H
@@ -0,0 +1,514 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/FileIngest.h"
+#else
+#   include "FileIngest.h"
+#endif
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#ifdef _WIN32
+#   include <io.h>
+#   include <malloc.h>
+#else
+#   include <unistd.h>
+#endif
+#if (FNR_HAS_IO_URING==1)
+#   include <linux/io_uring.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#endif
+
+namespace fnr
+{
+
+static const size_t kPageSize = 4096;
+
+//-----------------------------------------------------------------------------
+// Reads length bytes at offset, fewer only at the end of the file. Returns
+// the count, or -1 on an error.
+static long long ReadAt(int fd, CharType* buffer, size_t length,
+                        unsigned long long offset)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+#ifdef _WIN32
+        if (_lseeki64(fd, (long long)(offset + done), SEEK_SET) < 0)
+            return -1;
+        const long count = _read(fd, buffer + done, (unsigned int)(length - done));
+#else
+        const long count = (long)pread(fd, buffer + done, length - done,
+                                       (off_t)(offset + done));
+#endif
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (count == 0)
+            break;
+        done += (size_t)count;
+    }
+    return (long long)done;
+}
+
+//-----------------------------------------------------------------------------
+static CharType* AllocateBlocks(size_t size)
+{
+#ifdef _WIN32
+    return (CharType*)_aligned_malloc(size, kPageSize);
+#else
+    void* memory = 0;
+    return posix_memalign(&memory, kPageSize, size) == 0 ? (CharType*)memory : 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+static void FreeBlocks(CharType* blocks)
+{
+#ifdef _WIN32
+    _aligned_free(blocks);
+#else
+    free(blocks);
+#endif
+}
+
+#if (FNR_HAS_IO_URING==1)
+//-----------------------------------------------------------------------------
+// A bare io_uring driven by the two system calls, so no liburing is needed.
+// Only this thread submits and reaps, the barriers order the ring indexes
+// against the kernel.
+struct FileIngest::Ring
+{
+    int fd;
+    unsigned int* sqTail;
+    unsigned int sqMask;
+    unsigned int* sqArray;
+    io_uring_sqe* sqes;
+    unsigned int* cqHead;
+    unsigned int* cqTail;
+    unsigned int cqMask;
+    io_uring_cqe* cqes;
+    void* sqMap;
+    size_t sqMapSize;
+    void* cqMap;
+    size_t cqMapSize;
+    size_t sqesSize;
+    unsigned int inFlight;
+
+    static Ring* Create(unsigned int entries)
+    {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        const int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0)
+            return 0;
+
+        Ring* ring = new Ring;
+        memset(ring, 0, sizeof(Ring));
+        ring->fd = fd;
+        ring->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        ring->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+        {
+            if (ring->cqMapSize > ring->sqMapSize)
+                ring->sqMapSize = ring->cqMapSize;
+            ring->cqMapSize = ring->sqMapSize;
+        }
+
+        void* sqMap = mmap(0, ring->sqMapSize, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMap == MAP_FAILED)
+        {
+            Destroy(ring);
+            return 0;
+        }
+        ring->sqMap = sqMap;
+
+        void* cqMap = sqMap;
+        if (!single)
+        {
+            cqMap = mmap(0, ring->cqMapSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cqMap == MAP_FAILED)
+            {
+                Destroy(ring);
+                return 0;
+            }
+        }
+        ring->cqMap = cqMap;
+
+        ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(0, ring->sqesSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+        {
+            Destroy(ring);
+            return 0;
+        }
+        ring->sqes = (io_uring_sqe*)sqes;
+
+        char* sq = (char*)sqMap;
+        char* cq = (char*)cqMap;
+        ring->sqTail = (unsigned int*)(sq + params.sq_off.tail);
+        ring->sqMask = *(unsigned int*)(sq + params.sq_off.ring_mask);
+        ring->sqArray = (unsigned int*)(sq + params.sq_off.array);
+        ring->cqHead = (unsigned int*)(cq + params.cq_off.head);
+        ring->cqTail = (unsigned int*)(cq + params.cq_off.tail);
+        ring->cqMask = *(unsigned int*)(cq + params.cq_off.ring_mask);
+        ring->cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+        return ring;
+    }
+
+    static void Destroy(Ring* ring)
+    {
+        if (ring->sqes)
+            munmap(ring->sqes, ring->sqesSize);
+        if (ring->cqMap && ring->cqMap != ring->sqMap)
+            munmap(ring->cqMap, ring->cqMapSize);
+        if (ring->sqMap)
+            munmap(ring->sqMap, ring->sqMapSize);
+        close(ring->fd);
+        delete ring;
+    }
+
+    // Queues a read and hands it to the kernel at once.
+    bool Read(int file, CharType* buffer, size_t length,
+              unsigned long long offset, unsigned int tag)
+    {
+        const unsigned int tail = *sqTail;
+        const unsigned int index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = file;
+        sqe.addr = (unsigned long long)(size_t)buffer;
+        sqe.len = (unsigned int)length;
+        sqe.off = offset;
+        sqe.user_data = tag;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        if (Enter(1, 0) < 1)
+        {
+            // not taken: withdraw it, or a later submit would start it
+            __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+            return false;
+        }
+        ++inFlight;
+        return true;
+    }
+
+    // Takes one completion if there is one.
+    bool Reap(unsigned int& tag, int& result)
+    {
+        const unsigned int head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+            return false;
+        const io_uring_cqe& cqe = cqes[head & cqMask];
+        tag = (unsigned int)cqe.user_data;
+        result = cqe.res;
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        --inFlight;
+        return true;
+    }
+
+    int Wait() { return Enter(0, 1); }
+
+    int Enter(unsigned int submit, unsigned int wait)
+    {
+        for (;;)
+        {
+            const int result = (int)syscall(__NR_io_uring_enter, fd, submit, wait,
+                                            wait ? IORING_ENTER_GETEVENTS : 0, 0, 0);
+            if (result >= 0 || errno != EINTR)
+                return result;
+        }
+    }
+};
+#else
+struct FileIngest::Ring
+{
+    static Ring* Create(unsigned int) { return 0; }
+    static void Destroy(Ring* ring) { delete ring; }
+};
+#endif
+
+//-----------------------------------------------------------------------------
+FileIngest::FileIngest(size_t blockSize, unsigned int depth, bool useIoUring)
+  : blockSize_((blockSize + kPageSize - 1) / kPageSize * kPageSize),
+    depth_(depth ? depth : 1),
+    buffers_(0),
+    ring_(0)
+{
+    if (blockSize_ == 0)
+        blockSize_ = kPageSize;
+    buffers_ = AllocateBlocks(blockSize_ * depth_);
+    if (useIoUring && buffers_)
+        ring_ = Ring::Create(depth_);
+}
+
+//-----------------------------------------------------------------------------
+FileIngest::~FileIngest()
+{
+    if (ring_)
+        Ring::Destroy(ring_);
+    FreeBlocks(buffers_);
+}
+
+//-----------------------------------------------------------------------------
+bool FileIngest::run(const char* path, BlockSink& sink)
+{
+#ifdef _WIN32
+    const int fd = _open(path, _O_RDONLY | _O_BINARY);
+#else
+    const int fd = open(path, O_RDONLY);
+#endif
+    if (fd < 0)
+        return false;
+    const bool ok = run(fd, sink);
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+bool FileIngest::run(int fd, BlockSink& sink)
+{
+    if (!buffers_)
+        return false;
+
+    struct stat info;
+    bool ok;
+    if (fstat(fd, &info) != 0 || (info.st_mode & S_IFMT) != S_IFREG)
+        ok = RunStream(fd, sink);
+    else if (ring_)
+        ok = RunRing(fd, (unsigned long long)info.st_size, sink);
+    else
+        ok = RunBlocking(fd, (unsigned long long)info.st_size, sink);
+    sink.finish();
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+bool FileIngest::RunRing(int fd, unsigned long long size, BlockSink& sink)
+{
+#if (FNR_HAS_IO_URING==1)
+    const unsigned long long blocks = (size + blockSize_ - 1) / blockSize_;
+    // bytes read into each slot, -1 while its read is in flight
+    std::vector<long long> filled(depth_, 0);
+    unsigned long long next = 0;
+    bool ok = true;
+
+    for (; next < blocks && next < depth_; ++next)
+    {
+        filled[next] = -1;
+        if (!ring_->Read(fd, buffers_ + next * blockSize_, blockSize_,
+                         next * blockSize_, (unsigned int)next))
+            filled[next] = 0;   // read by ReadAt below
+    }
+
+    for (unsigned long long current = 0; ok && current < blocks; ++current)
+    {
+        const unsigned int slot = (unsigned int)(current % depth_);
+        unsigned int tag;
+        int result;
+        while (ok && filled[slot] < 0)
+        {
+            // the read may still land in the block, so it is not reused
+            if (ring_->Reap(tag, result))
+                filled[tag] = result > 0 ? result : 0;
+            else if (ring_->Wait() < 0)
+                ok = false;
+        }
+        if (!ok)
+            break;
+
+        // short or failed reads, an old kernel without IORING_OP_READ among
+        // them, are completed synchronously
+        CharType* block = buffers_ + slot * blockSize_;
+        const unsigned long long offset = current * blockSize_;
+        const size_t length = (size_t)(size - offset < blockSize_ ? size - offset : blockSize_);
+        long long count = filled[slot];
+        if ((size_t)count < length)
+        {
+            const long long rest = ReadAt(fd, block + count, length - (size_t)count,
+                                          offset + (unsigned long long)count);
+            if (rest < 0)
+                ok = false;
+            else
+                count += rest;
+        }
+        if (!ok)
+            break;
+
+        sink.consume(block, (size_t)count);
+
+        if (next < blocks)
+        {
+            filled[slot] = -1;
+            if (!ring_->Read(fd, block, blockSize_, next * blockSize_, slot))
+                filled[slot] = 0;
+            ++next;
+        }
+    }
+
+    // after an error no completion may be left to land in the buffers
+    unsigned int tag;
+    int result;
+    while (ring_->inFlight)
+    {
+        if (ring_->Reap(tag, result))
+            continue;
+        if (ring_->Wait() < 0 && errno != EAGAIN && errno != EBUSY)
+        {
+            // the reads left may still write to the buffers: give up the
+            // ring and leave the old buffers to them
+            Ring::Destroy(ring_);
+            ring_ = 0;
+            buffers_ = AllocateBlocks(blockSize_ * depth_);
+            return false;
+        }
+    }
+    return ok;
+#else
+    return RunBlocking(fd, size, sink);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool FileIngest::RunBlocking(int fd, unsigned long long size, BlockSink& sink)
+{
+    for (unsigned long long offset = 0; offset < size; offset += blockSize_)
+    {
+        const long long count = ReadAt(fd, buffers_, blockSize_, offset);
+        if (count < 0)
+            return false;
+        if (count == 0)
+            break;
+        sink.consume(buffers_, (size_t)count);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FileIngest::RunStream(int fd, BlockSink& sink)
+{
+    for (;;)
+    {
+#ifdef _WIN32
+        const long count = _read(fd, buffers_, (unsigned int)blockSize_);
+#else
+        const long count = (long)read(fd, buffers_, blockSize_);
+#endif
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        if (count == 0)
+            return true;
+        sink.consume(buffers_, (size_t)count);
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+NumberSink<T>::NumberSink(std::vector<T>& out, const DelimiterSet& delimiters,
+                          unsigned int threads)
+  : out_(out),
+    delimiters_(delimiters),
+    index_(delimiters),
+    threads_(threads),
+    failed_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void NumberSink<T>::consume(const CharType* data, size_t length)
+{
+    const CharType* end = data + length;
+    const CharType* first = FindSeparator(data, end, delimiters_);
+    carry_.append(data, first);
+    if (first == end)
+        return;     // the carried token goes on in the next block
+
+    if (!carry_.empty())
+    {
+        Parse(carry_.data(), carry_.size());
+        carry_.clear();
+    }
+
+    const CharType* last = end;
+    while (!IsSeparator(last[-1]))
+        --last;
+    Parse(first, (size_t)(last - first));
+    carry_.assign(last, end);
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void NumberSink<T>::finish()
+{
+    if (!carry_.empty())
+    {
+        Parse(carry_.data(), carry_.size());
+        carry_.clear();
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void NumberSink<T>::Parse(const CharType* text, size_t length)
+{
+    const size_t count = index_.build(text, length);
+    if (count == 0)
+        return;
+    const size_t begin = out_.size();
+    out_.resize(begin + count);
+    failed_ += ConvertTokens(text, index_, &out_[begin], 0, threads_);
+}
+
+//-----------------------------------------------------------------------------
+template class NumberSink<double>;
+template class NumberSink<float>;
+template class NumberSink<long double>;
+template class NumberSink<long>;
+template class NumberSink<int>;
+template class NumberSink<short>;
+
+} // end of fnr
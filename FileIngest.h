@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__FILEINGEST_H
+#define FAST_NUMBER_READER__FILEINGEST_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/StructuralIndex.h"
+#else
+#   include "StructuralIndex.h"
+#endif
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Receives the blocks of a file in file order. A block may end inside a
+// token, and its memory is reused as soon as consume() returns.
+class BlockSink
+{
+public:
+    virtual ~BlockSink() {}
+
+    virtual void consume(const CharType* data, size_t length) = 0;
+    // Called once after the last block.
+    virtual void finish() {}
+};
+
+//-----------------------------------------------------------------------------
+// Reads whole files in large blocks. With io_uring, depth reads are kept in
+// flight, so while the sink parses one block the following ones are being
+// read and storage latency hides behind parsing. Without it, or if the
+// kernel refuses a ring, every block is read with a plain pread before it
+// is consumed. Descriptors that are not regular files are read in order.
+class FileIngest
+{
+public:
+    explicit FileIngest(size_t blockSize = 1 << 20, unsigned int depth = 4,
+                        bool useIoUring = true);
+    ~FileIngest();
+
+    // True if reads go through io_uring.
+    bool asynchronous() const { return ring_ != 0; }
+    size_t blockSize() const { return blockSize_; }
+
+    // Streams the file to sink and calls sink.finish(). Returns false on a
+    // read error, blocks before the error have been consumed then.
+    bool run(int fd, BlockSink& sink);
+    // Opens path and runs it.
+    bool run(const char* path, BlockSink& sink);
+
+private:
+
+    FileIngest(const FileIngest&);
+    FileIngest& operator=(const FileIngest&);
+
+    struct Ring;
+
+    bool RunRing(int fd, unsigned long long size, BlockSink& sink);
+    bool RunBlocking(int fd, unsigned long long size, BlockSink& sink);
+    bool RunStream(int fd, BlockSink& sink);
+
+    size_t blockSize_;
+    unsigned int depth_;
+    CharType* buffers_;     // depth blocks, page aligned
+    Ring* ring_;
+
+};
+
+//-----------------------------------------------------------------------------
+// Parses the blocks with the two-stage bulk reader and appends the values.
+// The token cut by the end of a block is carried over to the next one.
+// Tokens that are not exactly one number give 0 and are counted.
+template <typename T>
+class NumberSink : public BlockSink
+{
+public:
+    explicit NumberSink(std::vector<T>& out,
+                        const DelimiterSet& delimiters = DelimiterSet(),
+                        unsigned int threads = 1);
+
+    void consume(const CharType* data, size_t length);
+    void finish();
+
+    size_t failed() const { return failed_; }
+
+private:
+
+    bool IsSeparator(CharType ch) const
+    {
+        return IsSpaceChar(ch) || delimiters_.contains(ch);
+    }
+
+    void Parse(const CharType* text, size_t length);
+
+    std::vector<T>& out_;
+    DelimiterSet delimiters_;
+    StructuralIndex index_;
+    std::string carry_;
+    unsigned int threads_;
+    size_t failed_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__FILEINGEST_H
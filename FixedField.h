@@ -0,0 +1,320 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__FIXEDFIELD_H
+#define FAST_NUMBER_READER__FIXEDFIELD_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/DecimalConvert.h"
+#else
+#   include "DecimalConvert.h"
+#endif
+
+#include <float.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+
+// Kernels for numbers in fixed-width columns (market data records, FORTRAN
+// style dumps, packed timestamps). The width is a template argument, so the
+// conversion is fully unrolled: 8 chars at once by SWAR arithmetic, the rest
+// one by one, and validity is computed from char class bit masks instead of
+// branching per char. Byte order of the SWAR code is little-endian.
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+inline uint64_t LoadEightChars(const CharType* p)
+{
+    uint64_t chunk;
+    memcpy(&chunk, p, sizeof(chunk));
+    return chunk;
+}
+
+//-----------------------------------------------------------------------------
+// 0x80 in every byte of chunk equal to ch.
+inline uint64_t EqualBytes(uint64_t chunk, CharType ch)
+{
+    const uint64_t kLow7 = 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t x = chunk ^ (0x0101010101010101ULL * (ByteType)ch);
+    uint64_t nonZero = (((x & kLow7) + kLow7) | x) & ~kLow7;
+    return nonZero ^ ~kLow7;
+}
+
+//-----------------------------------------------------------------------------
+// 0x80 in every byte of chunk that is a decimal digit.
+inline uint64_t DigitBytes(uint64_t chunk)
+{
+    const uint64_t kHigh = 0x8080808080808080ULL;
+    uint64_t low7 = chunk & ~kHigh;
+    uint64_t atLeast0 = (low7 + 0x5050505050505050ULL) & kHigh;    // >= '0'
+    uint64_t above9   = (low7 + 0x4646464646464646ULL) & kHigh;    // > '9'
+    return atLeast0 & ~above9 & ~(chunk & kHigh);
+}
+
+//-----------------------------------------------------------------------------
+// Packs the high bits of the 8 bytes into 8 bits, bit i from byte i.
+inline unsigned int ByteMaskBits(uint64_t byteMask)
+{
+    return (unsigned int)(((byteMask >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+//-----------------------------------------------------------------------------
+// Converts 8 decimal digits, the first char in the lowest byte.
+inline uint32_t ParseEightDigits(uint64_t chunk)
+{
+    uint64_t val = chunk - 0x3030303030303030ULL;
+    val = (val * 10) + (val >> 8);
+    val = (((val & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+           (((val >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t)val;
+}
+
+//-----------------------------------------------------------------------------
+// 0x80 in every byte of chunk that is a hex digit. Setting bit 5 folds
+// 'A'..'F' onto 'a'..'f' and leaves the digits alone, so one range test
+// covers the letters of both cases.
+inline uint64_t HexDigitBytes(uint64_t chunk)
+{
+    const uint64_t kHigh = 0x8080808080808080ULL;
+    uint64_t low7 = (chunk | 0x2020202020202020ULL) & ~kHigh;
+    uint64_t atLeastA = (low7 + 0x1F1F1F1F1F1F1F1FULL) & kHigh;    // >= 'a'
+    uint64_t aboveF   = (low7 + 0x1919191919191919ULL) & kHigh;    // > 'f'
+    return DigitBytes(chunk) | (atLeastA & ~aboveF & ~(chunk & kHigh));
+}
+
+//-----------------------------------------------------------------------------
+// Converts 8 hex digits, the first char in the lowest byte. A zero byte
+// counts as digit 0, other non-hex chars give garbage.
+inline uint32_t ParseEightHexDigits(uint64_t chunk)
+{
+    // low nibble, plus 9 for the letters (bit 6 set)
+    uint64_t val = (chunk & 0x0F0F0F0F0F0F0F0FULL) + ((chunk >> 6) & 0x0101010101010101ULL) * 9;
+    val = ((val << 4) | (val >> 8)) & 0x00FF00FF00FF00FFULL;
+    val = ((val << 8) | (val >> 16)) & 0x0000FFFF0000FFFFULL;
+    return (uint32_t)((val << 16) | (val >> 32));
+}
+
+//-----------------------------------------------------------------------------
+// Char class masks of a fixed field, bit i describes field[i].
+struct FixedFieldMasks
+{
+    uint64_t digits;
+    uint64_t spaces;
+    uint64_t signs;
+    uint64_t minus;
+};
+
+//-----------------------------------------------------------------------------
+// Converts field[I..N) treating non-digits as zeros and fills the masks.
+template <int I, int N, bool kWide = (N - I >= 8)>
+struct FixedFieldStep;
+
+template <int I, int N>
+struct FixedFieldStep<I, N, true>
+{
+    static uint64_t run(const CharType* field, uint64_t acc, FixedFieldMasks& m)
+    {
+        const uint64_t chunk = LoadEightChars(field + I);
+        const uint64_t digits = DigitBytes(chunk);
+        const uint64_t minus = EqualBytes(chunk, '-');
+        const uint64_t digitBytes = (digits >> 7) * 0xFF;
+
+        m.digits |= (uint64_t)ByteMaskBits(digits) << I;
+        m.spaces |= (uint64_t)ByteMaskBits(EqualBytes(chunk, ' ')) << I;
+        m.signs  |= (uint64_t)ByteMaskBits(minus | EqualBytes(chunk, '+')) << I;
+        m.minus  |= (uint64_t)ByteMaskBits(minus) << I;
+
+        uint64_t zeroed = (chunk & digitBytes) | (0x3030303030303030ULL & ~digitBytes);
+        acc = acc * 100000000ULL + ParseEightDigits(zeroed);
+        return FixedFieldStep<I + 8, N>::run(field, acc, m);
+    }
+};
+
+template <int I, int N>
+struct FixedFieldStep<I, N, false>
+{
+    static uint64_t run(const CharType* field, uint64_t acc, FixedFieldMasks& m)
+    {
+        const CharType ch = field[I];
+        const unsigned int digit = (ByteType)(ch - '0');
+        const uint64_t isDigit = digit <= 9;
+
+        m.digits |= isDigit << I;
+        m.spaces |= (uint64_t)(ch == ' ') << I;
+        m.signs  |= (uint64_t)(ch == '-' || ch == '+') << I;
+        m.minus  |= (uint64_t)(ch == '-') << I;
+
+        acc = acc * 10 + (digit & (0 - (unsigned int)isDigit));
+        return FixedFieldStep<I + 1, N>::run(field, acc, m);
+    }
+};
+
+template <int N>
+struct FixedFieldStep<N, N, false>
+{
+    static uint64_t run(const CharType*, uint64_t acc, FixedFieldMasks&)
+    {
+        return acc;
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Checks the "spaces, optional sign, digits" layout of an N chars field.
+template <int N>
+inline bool IsPaddedNumber(const FixedFieldMasks& m, bool digitsRequired)
+{
+    const uint64_t all = (N == 64) ? ~0ULL : ((1ULL << N) - 1);
+    const uint64_t padding = all & ~m.digits;
+    const uint64_t lastPadding = (padding + 1) >> 1;
+
+    return ((m.digits | m.spaces | m.signs) == all) &
+           ((padding & (padding + 1)) == 0) &
+           ((m.signs & ~lastPadding) == 0) &
+           (m.digits != 0 || !digitsRequired);
+}
+
+//-----------------------------------------------------------------------------
+// True if the digits among the first W - Room chars of a W chars field are
+// all zeros. The accumulator holds 19 digits, a field with more significant
+// digits than that has wrapped it.
+template <int W, int Room>
+inline bool LeadingDigitsAreZeros(const CharType* field, const FixedFieldMasks& m)
+{
+    for (int i = 0; i < W - Room; ++i)
+    {
+        if (((m.digits >> i) & 1) && field[i] != '0')
+            return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Sets value to the sign and digits of a field, false if it is outside T.
+template <typename T>
+struct FixedFieldValue
+{
+    static bool make(uint64_t scaled, bool neg, int, T& value)
+    {
+        typedef std::numeric_limits<T> Limits;
+        const uint64_t limit = !neg ? (uint64_t)Limits::max() :
+                               Limits::is_signed ? (uint64_t)Limits::max() + 1 : 0;
+        value = (T)(neg ? 0 - scaled : scaled);
+        return scaled <= limit;
+    }
+};
+
+inline void DecimalToFloating(const Decimal& d, float& value)       { value = DecimalToFloat(d); }
+inline void DecimalToFloating(const Decimal& d, double& value)      { value = DecimalToDouble(d); }
+inline void DecimalToFloating(const Decimal& d, long double& value) { value = DecimalToLongDouble(d); }
+
+// The quotient of the digits and 10^fracDigits is rounded once if both are
+// exact in T (digits up to kMaxExact, fracDigits up to kMaxExactPow10),
+// otherwise the digits go through DecimalConvert.
+template <typename T, uint64_t kMaxExact, int kMaxExactPow10>
+struct FixedFieldFloatValue
+{
+    static bool make(uint64_t scaled, bool neg, int fracDigits, T& value)
+    {
+        static const T kPow10[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        if (scaled <= kMaxExact && fracDigits <= kMaxExactPow10)
+        {
+            value = (T)scaled / kPow10[fracDigits];
+            value = neg ? -value : value;
+        }
+        else
+        {
+            const Decimal d = { scaled, 0, 0, -fracDigits, neg, false };
+            DecimalToFloating(d, value);
+        }
+        return true;
+    }
+};
+
+template <> struct FixedFieldValue<float>       : FixedFieldFloatValue<float, 1ULL << 24, 10> {};
+template <> struct FixedFieldValue<double>      : FixedFieldFloatValue<double, 1ULL << 53, 22> {};
+template <> struct FixedFieldValue<long double> :
+    FixedFieldFloatValue<long double, (LDBL_MANT_DIG >= 64) ? ~0ULL : (1ULL << 53), 22> {};
+
+//-----------------------------------------------------------------------------
+// Reads an integer from exactly N chars: leading spaces or zeros, an optional
+// sign right before the digits, at least one digit. Returns false if the
+// field has any other layout, more than 19 significant digits or a value
+// outside T.
+template <int N, typename T>
+inline bool ParseFixed(const CharType* field, T& value)
+{
+    static_assert(N > 0 && N <= 64, "fixed field width must be 1..64");
+
+    FixedFieldMasks m = { 0, 0, 0, 0 };
+    uint64_t acc = FixedFieldStep<0, N>::run(field, 0, m);
+    const bool fits = FixedFieldValue<T>::make(acc, m.minus != 0, 0, value);
+    return IsPaddedNumber<N>(m, true) & LeadingDigitsAreZeros<N, 19>(field, m) & fits;
+}
+
+//-----------------------------------------------------------------------------
+// Reads exactly N decimal digits with no padding or sign, as found in the
+// fields of dates and packed timestamps. Returns false on a value outside T.
+template <int N, typename T>
+inline bool ParseFixedDigits(const CharType* field, T& value)
+{
+    static_assert(N > 0 && N <= 19, "fixed digits width must be 1..19");
+
+    FixedFieldMasks m = { 0, 0, 0, 0 };
+    const bool fits = FixedFieldValue<T>::make(FixedFieldStep<0, N>::run(field, 0, m), false, 0, value);
+    return (m.digits == ((1ULL << N) - 1)) & fits;
+}
+
+//-----------------------------------------------------------------------------
+// Reads a fixed-point decimal from exactly N chars with the point at
+// field[N - F - 1] and F fraction digits (FORTRAN Fw.d style, e.g. "  -12.50"
+// for <8, 2>). The integer part is padded as in ParseFixed() but may have no
+// digits. Integer T gets the value scaled by 10^F, floating T the value.
+// The limits of ParseFixed() hold for the digits of both parts together.
+template <int N, int F, typename T>
+inline bool ParseFixedDecimal(const CharType* field, T& value)
+{
+    static_assert(F > 0 && F < N && F <= 19, "fixed decimal needs 1..19 fraction digits");
+
+    FixedFieldMasks intMasks = { 0, 0, 0, 0 };
+    FixedFieldMasks fracMasks = { 0, 0, 0, 0 };
+    uint64_t intPart = FixedFieldStep<0, N - F - 1>::run(field, 0, intMasks);
+    uint64_t scaled = FixedFieldStep<0, F>::run(field + N - F, intPart, fracMasks);
+
+    const bool fits = FixedFieldValue<T>::make(scaled, intMasks.minus != 0, F, value);
+    return IsPaddedNumber<N - F - 1>(intMasks, false) &
+           LeadingDigitsAreZeros<N - F - 1, 19 - F>(field, intMasks) &
+           (field[N - F - 1] == '.') &
+           (fracMasks.digits == ((1ULL << F) - 1)) & fits;
+}
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__FIXEDFIELD_H
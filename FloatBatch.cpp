@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/FloatBatch.h"
+#   include "FastNumberReader/DecimalConvert.h"
+#   include "FastNumberReader/FixedField.h"
+#   include "FastNumberReader/NumberReader.h"
+#else
+#   include "FloatBatch.h"
+#   include "DecimalConvert.h"
+#   include "FixedField.h"
+#   include "NumberReader.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Appends the digit run at p to mantissa, returns its length.
+static size_t AddDigitRun(const CharType*& p, const CharType* end, uint64_t& mantissa)
+{
+    const CharType* start = p;
+    while (end - p >= 8)
+    {
+        const uint64_t chunk = LoadEightChars(p);
+        if (DigitBytes(chunk) != 0x8080808080808080ULL)
+            break;
+        mantissa = mantissa * 100000000ULL + ParseEightDigits(chunk);
+        p += 8;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+        mantissa = mantissa * 10 + (*p - '0');
+    return p - start;
+}
+
+//-----------------------------------------------------------------------------
+size_t ReadSimpleFloat(const CharType* p, const CharType* end, float& value)
+{
+    const CharType* start = p;
+    Decimal d = { 0, 0, 0, 0, false, false };
+
+    if (p < end && (*p == '-' || *p == '+'))
+        d.negative = *p++ == '-';
+
+    const size_t intDigits = AddDigitRun(p, end, d.mantissa);
+    size_t fracDigits = 0;
+    if (p < end && *p == '.')
+    {
+        ++p;
+        fracDigits = AddDigitRun(p, end, d.mantissa);
+    }
+    if (!intDigits && !fracDigits)
+        return 0;
+    if (intDigits + fracDigits > 19)
+        return 0;
+
+    int exp10 = 0;
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negativeExp = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negativeExp = *p++ == '-';
+
+        const CharType* expStart = p;
+        for (; p < end && *p >= '0' && *p <= '9' && p - expStart < 6; ++p)
+            exp10 = exp10 * 10 + (*p - '0');
+        if (p == expStart || (p < end && *p >= '0' && *p <= '9'))
+            return 0;
+        if (negativeExp)
+            exp10 = -exp10;
+    }
+
+    d.exp10 = exp10 - (int)fracDigits;
+    value = DecimalToFloat(d);
+    return p - start;
+}
+
+//-----------------------------------------------------------------------------
+size_t ReadFloats(const CharType* text, size_t length, const DelimiterSet& delimiters,
+                  float* out, size_t capacity, size_t* consumed, TokenErrors* errors)
+{
+    const CharType* end = text + length;
+    const CharType* p = SkipDelimiters(text, end, delimiters);
+    NumberReader<float> reader;
+    size_t count = 0;
+
+    while (p < end && count < capacity)
+    {
+        float value;
+        size_t tokenLength = ReadSimpleFloat(p, end, value);
+        const CharType* tokenEnd = p + tokenLength;
+
+        if (!tokenLength ||
+            (tokenEnd < end && !IsSpaceChar(*tokenEnd) && !delimiters.contains(*tokenEnd)))
+        {
+            tokenLength = reader.read(p, end - p);
+            tokenEnd = p + tokenLength;
+            if (!tokenLength ||
+                (tokenEnd < end && !IsSpaceChar(*tokenEnd) && !delimiters.contains(*tokenEnd)))
+            {
+                // resync at the next separator
+                const CharType* badEnd = FindSeparator(tokenEnd, end, delimiters);
+                if (!errors || !errors->add(p - text, badEnd - p, tokenLength))
+                    break;
+                p = SkipDelimiters(badEnd, end, delimiters);
+                continue;
+            }
+            value = reader.value();
+        }
+
+        out[count++] = value;
+        p = SkipDelimiters(tokenEnd, end, delimiters);
+    }
+
+    if (consumed)
+        *consumed = p - text;
+    return count;
+}
+
+} // end of fnr
@@ -0,0 +1,62 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__FLOATBATCH_H
+#define FAST_NUMBER_READER__FLOATBATCH_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CharScan.h"
+#   include "FastNumberReader/TokenErrors.h"
+#else
+#   include "CharScan.h"
+#   include "TokenErrors.h"
+#endif
+
+#include <stddef.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Batch loader for float32 feature files. Tokens are split by whitespace
+// and delimiters; digits are taken 8 at a time by SWAR arithmetic and
+// rounded straight to float (DecimalToFloat()), tokens the fast loop does
+// not handle go through NumberReader<float>. Unlike the reader, whole
+// numbers without a point are accepted, feature files are full of them.
+// Stops at the first malformed token, returns the number of values written;
+// consumed (if not null) gets the chars consumed. Given errors, malformed
+// tokens are recorded there and skipped instead, until its limit is hit.
+size_t ReadFloats(const CharType* text, size_t length, const DelimiterSet& delimiters,
+                  float* out, size_t capacity, size_t* consumed, TokenErrors* errors = 0);
+
+// The fast loop of ReadFloats for one token at p: [sign] digits [. digits]
+// [e [sign] digits] of at most 19 digits. Returns the token length, or 0
+// to let NumberReader<float> decide. The char after the token is not
+// checked.
+size_t ReadSimpleFloat(const CharType* p, const CharType* end, float& value);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__FLOATBATCH_H
@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/HexDecode.h"
+#   include "FastNumberReader/CharScan.h"
+#   include "FastNumberReader/FixedField.h"
+#else
+#   include "HexDecode.h"
+#   include "CharScan.h"
+#   include "FixedField.h"
+#endif
+
+#if (FNR_SSE2==1)
+#   include <emmintrin.h>
+#endif
+
+namespace fnr
+{
+
+#if (FNR_SSE2==1)
+//-----------------------------------------------------------------------------
+// Decodes the hex digits of 16 chars, first char in the highest nibble;
+// returns how many chars from the first are hex digits.
+static int DecodeSixteenHex(const CharType* p, uint64_t& digits)
+{
+    const __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+
+    // ch - '0' and (ch | 0x20) - 'a' as unsigned bytes
+    const __m128i d = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    const __m128i l = _mm_sub_epi8(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    const __m128i isHex = _mm_or_si128(isDigit, isLetter);
+
+    const unsigned int bits = (unsigned int)_mm_movemask_epi8(isHex);
+    const int run = (bits == 0xFFFF) ? 16 : LowestBitIndex(~bits & 0xFFFF);
+
+    // nibbles of the hex digits, 0 elsewhere, then pairs, quads and octets
+    __m128i x = _mm_and_si128(_mm_add_epi8(_mm_and_si128(chunk, _mm_set1_epi8(0x0F)),
+                                           _mm_and_si128(isLetter, _mm_set1_epi8(9))), isHex);
+    x = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(x, 4), _mm_srli_epi16(x, 8)),
+                      _mm_set1_epi16(0x00FF));
+    x = _mm_and_si128(_mm_or_si128(_mm_slli_epi32(x, 8), _mm_srli_epi32(x, 16)),
+                      _mm_set1_epi32(0x0000FFFF));
+    x = _mm_and_si128(_mm_or_si128(_mm_slli_epi64(x, 16), _mm_srli_epi64(x, 32)),
+                      _mm_set_epi32(0, -1, 0, -1));
+
+    uint64_t halves[2];
+    _mm_storeu_si128((__m128i*)halves, x);
+    digits = (halves[0] << 32) | halves[1];
+    return run;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+size_t DecodeHexRun(const CharType* p, const CharType* end, uint64_t& value)
+{
+    const CharType* start = p;
+
+#if (FNR_SSE2==1)
+    while (end - p >= 16)
+    {
+        uint64_t digits;
+        const int run = DecodeSixteenHex(p, digits);
+        if (run == 16)
+        {
+            value = digits;
+            p += 16;
+            continue;
+        }
+        if (run)
+            value = (value << (4 * run)) | (digits >> (4 * (16 - run)));
+        return p + run - start;
+    }
+#endif
+
+    while (end - p >= 8)
+    {
+        const uint64_t chunk = LoadEightChars(p);
+        const uint64_t hex = HexDigitBytes(chunk);
+        if (hex == 0x8080808080808080ULL)
+        {
+            value = (value << 32) | ParseEightHexDigits(chunk);
+            p += 8;
+            continue;
+        }
+
+        const uint64_t others = ~hex & 0x8080808080808080ULL;
+        const int run = LowestBitIndex64(others) / 8;
+        if (run)
+        {
+            // keep the run, zero the rest, and drop its nibbles
+            const uint64_t keep = ~0ULL >> (64 - 8 * run);
+            value = (value << (4 * run)) | (ParseEightHexDigits(chunk & keep) >> (4 * (8 - run)));
+        }
+        return p + run - start;
+    }
+
+    for (; p < end; ++p)
+    {
+        const CharType ch = *p;
+        const CharType folded = (CharType)(ch | 0x20);
+        if (!((ch >= '0' && ch <= '9') || (folded >= 'a' && folded <= 'f')))
+            break;
+        value = (value << 4) | (uint64_t)((ch & 0x0F) + 9 * ((ch >> 6) & 1));
+    }
+    return p - start;
+}
+
+//-----------------------------------------------------------------------------
+size_t ReadHex64(const CharType* str, size_t length, uint64_t& value)
+{
+    const CharType* p = str;
+    const CharType* end = str + length;
+    if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+        p += 2;
+
+    // a run of 17 tells too long from just fitting
+    uint64_t digits = 0;
+    const CharType* runEnd = (end - p > 17) ? p + 17 : end;
+    const size_t run = DecodeHexRun(p, runEnd, digits);
+    if (!run || run > 16)
+        return 0;
+
+    value = digits;
+    return p + run - str;
+}
+
+} // end of fnr
@@ -0,0 +1,56 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__HEXDECODE_H
+#define FAST_NUMBER_READER__HEXDECODE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Appends the run of hex digits at p to value (value * 16 + digit per
+// digit, modulo 2^64), returns the length of the run. Digits are validated
+// and converted 16 per step with SSE2, 8 per step by SWAR arithmetic
+// otherwise; case folding is a bit trick, there are no lookups.
+size_t DecodeHexRun(const CharType* p, const CharType* end, uint64_t& value);
+
+//-----------------------------------------------------------------------------
+// Raw hex for hashes, addresses and IDs: reads an optional "0x" or "0X"
+// and 1..16 hex digits at str. Returns the chars consumed, or 0 (value
+// untouched) if there are no digits or more than 16 of them.
+size_t ReadHex64(const CharType* str, size_t length, uint64_t& value);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__HEXDECODE_H
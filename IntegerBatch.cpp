@@ -0,0 +1,240 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/IntegerBatch.h"
+#   include "FastNumberReader/FixedField.h"
+#   include "FastNumberReader/NumberReader.h"
+#else
+#   include "IntegerBatch.h"
+#   include "FixedField.h"
+#   include "NumberReader.h"
+#endif
+
+#include <string.h>
+#if (FNR_SSE2==1)
+#   include <emmintrin.h>
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Loads the 8 chars at p, zeros for the ones at or past end.
+static inline uint64_t LoadLane(const CharType* p, const CharType* end)
+{
+    if (end - p >= 8)
+        return LoadEightChars(p);
+
+    uint64_t chunk = 0;
+    memcpy(&chunk, p, end - p);
+    return chunk;
+}
+
+//-----------------------------------------------------------------------------
+// Turns every lane of right-aligned digit values (the first digit in the
+// lowest byte, leading zeros in front) into its number.
+static inline void ReduceLanes(uint64_t* lanes, unsigned int count)
+{
+#if (FNR_SSE2==1)
+    const __m128i kLowBytes = _mm_set1_epi16(0x00FF);
+    const __m128i kTen = _mm_set1_epi16(10);
+    const __m128i kHundredOne = _mm_set1_epi32((1 << 16) | 100);
+    const __m128i kTenThousand = _mm_set1_epi32(10000);
+
+    for (unsigned int i = 0; i < count; i += 2)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)&lanes[i]);
+        // 2 digits per 16 bits, 4 per 32 bits, 8 per 64 bits
+        x = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(x, kLowBytes), kTen),
+                          _mm_srli_epi16(x, 8));
+        x = _mm_madd_epi16(x, kHundredOne);
+        x = _mm_add_epi64(_mm_mul_epu32(x, kTenThousand), _mm_srli_epi64(x, 32));
+        _mm_storeu_si128((__m128i*)&lanes[i], x);
+    }
+#else
+    for (unsigned int i = 0; i < count; ++i)
+        lanes[i] = ParseEightDigits(lanes[i] + 0x3030303030303030ULL);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+unsigned int ConvertIntegerLanes(const CharType* text, size_t length,
+                                 const size_t* begins, const size_t* ends,
+                                 unsigned int count, T* values)
+{
+    const CharType* end = text + length;
+    uint64_t lanes[kIntegerLanes];
+    bool negative[kIntegerLanes];
+    unsigned int converted = 0;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const CharType* p = text + begins[i];
+        size_t digits = ends[i] - begins[i];
+
+        negative[i] = false;
+        if (digits && (*p == '-' || *p == '+'))
+        {
+            negative[i] = *p++ == '-';
+            --digits;
+        }
+
+        lanes[i] = 0;
+        if (digits - 1 >= 8 || *p == '0')
+            continue;
+
+        const uint64_t keep = ~0ULL >> (64 - 8 * digits);
+        const uint64_t chunk = LoadLane(p, end) & keep;
+        if ((DigitBytes(chunk) & keep) != (0x8080808080808080ULL & keep))
+            continue;
+
+        lanes[i] = (chunk - (0x3030303030303030ULL & keep)) << (64 - 8 * digits);
+        converted |= 1u << i;
+    }
+
+    if (count & 1)
+        lanes[count] = 0;
+    ReduceLanes(lanes, count);
+
+    // 8 digits may not fit a short: such a lane goes to the reader, which
+    // rejects it
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const long value = negative[i] ? -(long)lanes[i] : (long)lanes[i];
+        if ((long)(T)value == value)
+            values[i] = (T)value;
+        else
+            converted &= ~(1u << i);
+    }
+
+    return converted;
+}
+
+//-----------------------------------------------------------------------------
+// The separator that ends the token at p, a leading run of digits is
+// skipped 8 chars at a time. separators[ch] is true for whitespace and the
+// delimiters.
+static const CharType* FindTokenEnd(const CharType* p, const CharType* end,
+                                    const bool* separators)
+{
+    if (p < end && (*p == '-' || *p == '+'))
+        ++p;
+    if (end - p >= 8)
+    {
+        const uint64_t others = ~DigitBytes(LoadEightChars(p)) & 0x8080808080808080ULL;
+        p += others ? LowestBitIndex64(others) / 8 : 8;
+    }
+    while (p < end && !separators[(ByteType)*p])
+        ++p;
+    return p;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+size_t ReadIntegers(const CharType* text, size_t length, const DelimiterSet& delimiters,
+                    T* out, size_t capacity, size_t* consumed, TokenErrors* errors)
+{
+    const CharType* end = text + length;
+    const CharType* p = SkipDelimiters(text, end, delimiters);
+    NumberReader<T> reader;
+    bool separators[256];
+    size_t begins[kIntegerLanes];
+    size_t ends[kIntegerLanes];
+    size_t count = 0;
+
+    for (int ch = 0; ch < 256; ++ch)
+        separators[ch] = IsSpaceChar((CharType)ch) || delimiters.contains((CharType)ch);
+
+    while (p < end && count < capacity)
+    {
+        unsigned int n = 0;
+        const CharType* next = p;
+        while (next < end && n < kIntegerLanes && count + n < capacity)
+        {
+            const CharType* tokenEnd = FindTokenEnd(next, end, separators);
+            begins[n] = next - text;
+            ends[n] = tokenEnd - text;
+            ++n;
+            // mostly a single separator, skip it without a call
+            next = tokenEnd + (tokenEnd < end);
+            if (next < end && separators[(ByteType)*next])
+                next = SkipDelimiters(next, end, delimiters);
+        }
+
+        const unsigned int converted =
+            ConvertIntegerLanes(text, length, begins, ends, n, out + count);
+
+        // skipped bad tokens move the values after them down
+        size_t written = count;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            if (converted & (1u << i))
+            {
+                out[written++] = out[count + i];
+                continue;
+            }
+
+            const size_t tokenLength = ends[i] - begins[i];
+            const size_t validLength = reader.read(text + begins[i], tokenLength);
+            if (validLength != tokenLength)
+            {
+                if (!errors || !errors->add(begins[i], tokenLength, validLength))
+                {
+                    if (consumed)
+                        *consumed = begins[i];
+                    return written;
+                }
+                continue;
+            }
+            out[written++] = reader.value();
+        }
+
+        count = written;
+        p = next;
+    }
+
+    if (consumed)
+        *consumed = p - text;
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+template unsigned int ConvertIntegerLanes<long>(const CharType*, size_t, const size_t*,
+                                                const size_t*, unsigned int, long*);
+template unsigned int ConvertIntegerLanes<int>(const CharType*, size_t, const size_t*,
+                                               const size_t*, unsigned int, int*);
+template unsigned int ConvertIntegerLanes<short>(const CharType*, size_t, const size_t*,
+                                                 const size_t*, unsigned int, short*);
+
+template size_t ReadIntegers<long>(const CharType*, size_t, const DelimiterSet&,
+                                   long*, size_t, size_t*, TokenErrors*);
+template size_t ReadIntegers<int>(const CharType*, size_t, const DelimiterSet&,
+                                  int*, size_t, size_t*, TokenErrors*);
+template size_t ReadIntegers<short>(const CharType*, size_t, const DelimiterSet&,
+                                    short*, size_t, size_t*, TokenErrors*);
+
+} // end of fnr
@@ -0,0 +1,74 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__INTEGERBATCH_H
+#define FAST_NUMBER_READER__INTEGERBATCH_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CharScan.h"
+#   include "FastNumberReader/TokenErrors.h"
+#else
+#   include "CharScan.h"
+#   include "TokenErrors.h"
+#endif
+
+#include <stddef.h>
+
+namespace fnr
+{
+
+enum { kIntegerLanes = 8 };
+
+//-----------------------------------------------------------------------------
+// Lane kernel for short integer fields (ports, status codes, counts) whose
+// boundaries are already known: converts the count <= kIntegerLanes tokens
+// [begins[i], ends[i]) of text at once. Each token is checked and
+// right-aligned in a 64-bit lane, then all lanes go through the same
+// multiply-add reduction, two lanes per SSE2 register. Only an optional
+// sign and 1..8 digits, the first of them not 0, with a value that fits T
+// are taken (a leading 0 is a lone zero or starts a hex number, the reader
+// tells); values[i] is written and bit i of the result set for every token
+// converted, the rest are left to NumberReader<T>. length is the size of
+// text, nothing past it is loaded.
+template <typename T>
+unsigned int ConvertIntegerLanes(const CharType* text, size_t length,
+                                 const size_t* begins, const size_t* ends,
+                                 unsigned int count, T* values);
+
+//-----------------------------------------------------------------------------
+// Batch loader for short, int and long fields split by whitespace and
+// delimiters. Token boundaries are found kIntegerLanes at a time and handed
+// to ConvertIntegerLanes(), tokens it does not take go through
+// NumberReader<T>. Stops at the first malformed token, returns the number
+// of values written; consumed (if not null) gets the chars consumed. Given
+// errors, malformed tokens are recorded there and skipped instead, until
+// its limit is hit.
+template <typename T>
+size_t ReadIntegers(const CharType* text, size_t length, const DelimiterSet& delimiters,
+                    T* out, size_t capacity, size_t* consumed, TokenErrors* errors = 0);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__INTEGERBATCH_H
@@ -0,0 +1,128 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/LazyNumberColumn.h"
+#else
+#   include "LazyNumberColumn.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+template <typename T>
+LazyNumberColumn<T>::LazyNumberColumn(const DelimiterSet& delimiters) :
+    text_(0), index_(delimiters)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+LazyNumberColumn<T>::~LazyNumberColumn()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+size_t LazyNumberColumn<T>::open(const CharType* text, size_t length)
+{
+    close();
+    text_ = text;
+    index_.build(text, length);
+    pages_.assign((index_.size() + kPageSize - 1) / kPageSize, (Page*)0);
+    return index_.size();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void LazyNumberColumn<T>::close()
+{
+    for (size_t i = 0; i < pages_.size(); ++i)
+        delete pages_[i];
+    pages_.clear();
+    index_.build(0, 0);
+    text_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+size_t LazyNumberColumn<T>::tokenLength(size_t i) const
+{
+    const size_t begin = index_.tokenBegin(i);
+    return index_.tokenEnd(begin) - begin;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+typename LazyNumberColumn<T>::Page* LazyNumberColumn<T>::Convert(size_t i)
+{
+    Page*& page = pages_[i / kPageSize];
+    if (!page)
+        page = new Page();
+
+    const size_t slot = i % kPageSize;
+    const uint64_t bit = (uint64_t)1 << (slot % 64);
+    if (!(page->converted[slot / 64] & bit))
+    {
+        const size_t begin = index_.tokenBegin(i);
+        const size_t length = index_.tokenEnd(begin) - begin;
+        if (reader_.read(text_ + begin, length) == length)
+        {
+            page->values[slot] = reader_.value();
+            page->valid[slot / 64] |= bit;
+        }
+        page->converted[slot / 64] |= bit;
+    }
+
+    return page;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+T LazyNumberColumn<T>::value(size_t i)
+{
+    return Convert(i)->values[i % kPageSize];
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+bool LazyNumberColumn<T>::valid(size_t i)
+{
+    const size_t slot = i % kPageSize;
+    return (Convert(i)->valid[slot / 64] >> (slot % 64)) & 1;
+}
+
+//-----------------------------------------------------------------------------
+template class LazyNumberColumn<double>;
+template class LazyNumberColumn<float>;
+template class LazyNumberColumn<long double>;
+template class LazyNumberColumn<long>;
+template class LazyNumberColumn<int>;
+template class LazyNumberColumn<short>;
+
+} // end of fnr
@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__LAZYNUMBERCOLUMN_H
+#define FAST_NUMBER_READER__LAZYNUMBERCOLUMN_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReader.h"
+#   include "FastNumberReader/StructuralIndex.h"
+#else
+#   include "NumberReader.h"
+#   include "StructuralIndex.h"
+#endif
+
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Column over a text that is only indexed when opened: a value is converted
+// the first time it is asked for and cached. Opening costs one structural
+// index pass and no conversion or value storage, cache pages of kPageSize
+// values are allocated as they are touched, so reading a few percent of a
+// huge file costs about that much.
+//
+// Tokens are split by whitespace and delimiters; a token that is not a
+// number reads as 0 and is not valid(). Not thread-safe: access caches.
+template <typename T>
+class LazyNumberColumn
+{
+public:
+    enum { kPageSize = 256 };
+
+    explicit LazyNumberColumn(const DelimiterSet& delimiters = DelimiterSet());
+    ~LazyNumberColumn();
+
+    // text must stay valid (e.g. mapped) while the column is used.
+    size_t open(const CharType* text, size_t length);
+    void close();
+
+    size_t size() const { return index_.size(); }
+
+    T operator[](size_t i) { return value(i); }
+    T value(size_t i);
+    bool valid(size_t i);
+
+    // Where token i is in the text, for skipping to the Nth number.
+    size_t tokenOffset(size_t i) const { return index_.tokenBegin(i); }
+    size_t tokenLength(size_t i) const;
+
+private:
+
+    enum { kMaskWords = kPageSize / 64 };
+
+    struct Page
+    {
+        T values[kPageSize];
+        uint64_t converted[kMaskWords];
+        uint64_t valid[kMaskWords];
+    };
+
+    Page* Convert(size_t i);
+
+    LazyNumberColumn(const LazyNumberColumn&);
+    LazyNumberColumn& operator=(const LazyNumberColumn&);
+
+    const CharType* text_;
+    StructuralIndex index_;
+    std::vector<Page*> pages_;
+
+    NumberReader<T> reader_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__LAZYNUMBERCOLUMN_H
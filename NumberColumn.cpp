@@ -0,0 +1,114 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberColumn.h"
+#else
+#   include "NumberColumn.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+template <typename T>
+NumberColumn<T>::NumberColumn() : nullCount_(0)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void NumberColumn<T>::append(T value)
+{
+    const size_t i = values_.size();
+    if (!(i & 7))
+        validity_.push_back(0);
+    validity_[i >> 3] |= (ByteType)(1 << (i & 7));
+    values_.push_back(value);
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void NumberColumn<T>::appendNull()
+{
+    if (!(values_.size() & 7))
+        validity_.push_back(0);
+    values_.push_back(T(0));
+    ++nullCount_;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void NumberColumn<T>::clear()
+{
+    values_.clear();
+    validity_.clear();
+    nullCount_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+size_t NumberColumn<T>::read(const CharType* text, size_t length, const DelimiterSet& delimiters)
+{
+    const CharType* end = text + length;
+    const bool bySpaces = delimiters.count() == 0;
+    const DelimiterSet tokenEnds = bySpaces ? DelimiterSet(" \t\n\r\v") : delimiters;
+    const size_t sizeBefore = size();
+
+    const CharType* p = bySpaces ? SkipSpaces(text, end) : text;
+    while (p < end)
+    {
+        // spaces around a token are padding, a token of spaces only is empty
+        const CharType* tokenEnd = FindDelimiter(p, end, tokenEnds);
+        const CharType* token = SkipSpaces(p, tokenEnd);
+        size_t tokenLength = 0;
+        if (token < tokenEnd)
+            tokenLength = reader_.read(token, tokenEnd - token);
+
+        if (tokenLength && SkipSpaces(token + tokenLength, tokenEnd) == tokenEnd)
+            append(reader_.value());
+        else
+            appendNull();
+
+        p = tokenEnd;
+        if (bySpaces)
+            p = SkipSpaces(p, end);
+        else if (p < end)
+            ++p;
+    }
+
+    return size() - sizeBefore;
+}
+
+//-----------------------------------------------------------------------------
+template class NumberColumn<double>;
+template class NumberColumn<float>;
+template class NumberColumn<long double>;
+template class NumberColumn<long>;
+template class NumberColumn<int>;
+template class NumberColumn<short>;
+
+} // end of fnr
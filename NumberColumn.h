@@ -0,0 +1,81 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__NUMBERCOLUMN_H
+#define FAST_NUMBER_READER__NUMBERCOLUMN_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReader.h"
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "NumberReader.h"
+#   include "CharScan.h"
+#endif
+
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Nullable column in the Arrow layout: contiguous values and a packed
+// validity bitmap, bit i (LSB first) set if value i is not null. Null slots
+// hold 0, so values() can be handed over without a second pass.
+template <typename T>
+class NumberColumn
+{
+public:
+    NumberColumn();
+
+    void append(T value);
+    void appendNull();
+    void clear();
+
+    // Reads tokens of text split by delimiters (by whitespace if the set is
+    // empty). Empty and malformed tokens are appended as nulls instead of
+    // stopping the read. Returns the number of values appended.
+    size_t read(const CharType* text, size_t length, const DelimiterSet& delimiters);
+
+    size_t size() const { return values_.size(); }
+    size_t nullCount() const { return nullCount_; }
+    bool valid(size_t i) const { return (validity_[i >> 3] >> (i & 7)) & 1; }
+
+    const T* values() const { return values_.empty() ? 0 : &values_[0]; }
+    const ByteType* validity() const { return validity_.empty() ? 0 : &validity_[0]; }
+    T operator[](size_t i) const { return values_[i]; }
+
+private:
+
+    std::vector<T> values_;
+    std::vector<ByteType> validity_;
+    size_t nullCount_;
+
+    NumberReader<T> reader_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__NUMBERCOLUMN_H
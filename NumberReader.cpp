@@ -28,16 +28,23 @@ SOFTWARE.
 //#define FNR_INCLUDED_IN_LARGER_PROJECT
 #ifdef FNR_INCLUDED_IN_LARGER_PROJECT
 #   include "FastNumberReader/NumberReader.h"
+#   include "FastNumberReader/CharScan.h"
+#   include "FastNumberReader/DecimalConvert.h"
+#   include "FastNumberReader/HexDecode.h"
 #else
 #   include "NumberReader.h"
+#   include "CharScan.h"
+#   include "DecimalConvert.h"
+#   include "HexDecode.h"
 #endif
 
+#include <limits.h>
 #include <new>
 #include <vector>
 #ifdef FNR_DEBUG
 #   include <assert.h>
 #else
-#define assert() ((void)0)
+#define assert(x) ((void)0)
 #endif
 
 namespace fnr
@@ -58,6 +65,7 @@ enum eCharClass
     kCC_Count
 };
 
+#if (FNR_GETCHARCLASS==1)
 static const CharType* alphabet[kCC_Count] =
 {
     "+-",
@@ -71,7 +79,6 @@ static const CharType* alphabet[kCC_Count] =
     "uU"
 };
 
-#if (FNR_GETCHARCLASS==1)
 static int IsCharIn(CharType ch, const char* str)
 {
     if (!str)
@@ -88,35 +95,23 @@ static int IsCharIn(CharType ch, const char* str)
 
 static int ToDigit(CharType ch)
 {
-    const char* str = alphabet[kCC_Digit];
-    for (int i = 0; str[i]; ++i)
-    {
-        if (ch == str[i]) return i;
-    }
+    return (ch >= '0' && ch <= '9') ? ch - '0' : 0;
+}
 
-    return 0;
+static inline bool IsDigit(CharType ch)
+{
+    return ch >= '0' && ch <= '9';
 }
 
+// ch is one of "abcdefABCDEF", whose low nibbles are 1..6 in both cases.
 static int ToHexDigit(CharType ch)
 {
-    const char* str = alphabet[kCC_HexDigit];
-    for (int i = 0; str[i]; ++i)
-    {
-        if (ch == str[i])
-        {
-            if (i >= 6)
-                return i - 6 + 10;
-            else
-                return i + 10;
-        }
-    }
-
-    return 0;
+    return (ch & 0x0F) + 9;
 }
 
 //-----------------------------------------------------------------------------
 
-static eCharClass GetCharClass(const CharType ch, bool fHexDigit = false)
+static inline eCharClass GetCharClass(const CharType ch, bool fHexDigit = false)
 {
 #if (FNR_GETCHARCLASS==0)
 
@@ -197,29 +192,40 @@ static eCharClass GetCharClass(const CharType ch, bool fHexDigit = false)
 }
 
 //-----------------------------------------------------------------------------
-bool isSpace(CharType ch)
+static bool isSpace(CharType ch)
 {
-    if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v')
-        return true;
-    return false;
+    // '\t' '\n' '\v' '\r' are 9, 10, 11, 13
+    return ch == ' ' || (ch >= '\t' && ch <= '\r' && ch != '\f');
 }
 
 //-----------------------------------------------------------------------------
-double pow(double x, int e)
+// ReaderState::flags layout, shared by both readers. Digit counters are
+// only ever compared with zero, so a saved state keeps one bit for each.
+enum eStateFlags
 {
-    double y = 1.0;
-    if (e > 0)
-    {
-        for (int i = 0; i < e; ++i)
-        {
-            y *= x;
-        }
-    }
-    else if (e < 0)
-    {
-        y = 1.0 / pow(x, -e);
-    }
-    return y;
+    kSF_StateMask       = 0x7,
+    kSF_Valid           = 1 << 3,
+    kSF_Negative        = 1 << 4,
+    kSF_Truncated       = 1 << 5,
+    kSF_ExpNegative     = 1 << 6,
+    kSF_TrailingSpace   = 1 << 7,
+    kSF_IntDigits       = 1 << 8,
+    kSF_FracDigits      = 1 << 9,
+    kSF_HexDigits       = 1 << 9,
+    kSF_ExpDigits       = 1 << 10,
+    kSF_TailDigitsShift = 11,
+    kSF_ExpValueShift   = 16
+};
+
+static const int kMaxExpValue = 0xffff;
+
+//-----------------------------------------------------------------------------
+static int CountDigits(uint64_t value)
+{
+    int digits = 0;
+    for (; value; value /= 10)
+        ++digits;
+    return digits;
 }
 
 //*****************************************************************************
@@ -252,27 +258,25 @@ public:
 
 private:
 
-    struct State;
-
-    static State* GetState(eState state);
-
     struct Data
     {
-        friend struct State;
-
-        Data() : state_(0), type_(kDouble)
+        Data() : type_(kDouble)
         {
             reset();
         }
 
         void reset()
         {
-            state_ = 0;
+            stateId_ = kInitState;
             valid_ = false;
 
-            sign_ = 1.0;
-            value_ = 0.0;
-            fracScale_ = 0.0;
+            negative_ = false;
+            mantissa_ = 0;
+            mantissaDigits_ = 0;
+            tail_ = 0;
+            tailDigits_ = 0;
+            exp10Adjust_ = 0;
+            truncated_ = false;
             expSign_ = 1;
             expValue_ = 0;
 
@@ -290,20 +294,165 @@ private:
 
         int put(CharType ch)
         {
-            if (!state_)
-                GoTo(kInitState);
-            return state_->put(ch);
+            // a switch over the state id, no virtual call or state lookup
+            switch (stateId_)
+            {
+                case kInitState:      return PutInit(ch);
+                case kWaitIDP_State:  return PutWaitIDP(ch);
+                case kWaitIDPE_State: return PutWaitIDPE(ch);
+                case kWaitFD_State:   return PutWaitFD(ch);
+                case kWaitFDES_State: return PutWaitFDES(ch);
+                case kWaitESD_State:  return PutWaitESD(ch);
+                case kWaitEDS_State:  return PutWaitEDS(ch);
+                case kWaitTS_State:   return PutWaitTS(ch);
+                default: break;
+            }
+            return 0;
+        }
+
+        // The grammar of put() in one pass, with no state dispatch per char.
+        // Past the first valid prefix only an exponent can be left unfinished,
+        // so that is all there is to undo when the number stops early. With
+        // integers, digits alone are a number too.
+        size_t read(const CharType* str, size_t length, bool integers = false)
+        {
+            reset();
+
+            // leading padding is skipped in bulk, and the first space after
+            // the number ends it: trailing spaces never extend the prefix
+            const CharType* end = str + length;
+            const CharType* p = SkipSpaces(str, end);
+            const CharType* accepted = 0;
+
+            if (p < end && (*p == '-' || *p == '+'))
+                SetSign(*p++);
+            for (; p < end && IsDigit(*p); ++p)
+                AddIntDigit(*p);
+
+            if (intDigits_)
+            {
+                GoTo(kWaitIDPE_State);
+                if (integers)
+                    accepted = p;
+            }
+
+            if (p < end && *p == '.')
+            {
+                ++p;
+                for (; p < end && IsDigit(*p); ++p)
+                    AddFracDigit(*p);
+                if (intDigits_ || fracDigits_)
+                    accepted = p;
+                GoTo(kWaitFDES_State);
+            }
+
+            // an exponent needs digits before it, and counts with its own
+            if ((intDigits_ || fracDigits_) && p < end && (*p == 'e' || *p == 'E'))
+            {
+                const CharType* q = p + 1;
+                if (q < end && (*q == '-' || *q == '+'))
+                    SetExpSign(*q++);
+                for (; q < end && IsDigit(*q); ++q)
+                    AddExpDigit(*q);
+
+                if (expDigits_)
+                {
+                    accepted = q;
+                    GoTo(kWaitEDS_State);
+                }
+                else
+                {
+                    expSign_ = 1;
+                }
+            }
+
+            if (!accepted)
+            {
+                reset();
+                return 0;
+            }
+
+            p = accepted;
+            if (stateId_ != kWaitIDPE_State && p < end &&
+                ((type_ == kFloat && (*p == 'f' || *p == 'F')) ||
+                 (type_ == kLongDouble && (*p == 'l' || *p == 'L'))))
+            {
+                ++p;
+                GoTo(kWaitTS_State);
+            }
+
+            SetValid();
+            return p - str;
         }
 
         void GoTo(eState state)
         {
-            state_ = GetState(state);
+            stateId_ = state;
+        }
+
+        ReaderState save() const
+        {
+            ReaderState saved;
+            saved.digits = mantissa_;
+            saved.tail = tail_;
+            saved.exp10 = exp10Adjust_;
+            saved.flags = (uint32_t)stateId_ |
+                (valid_ ? kSF_Valid : 0) |
+                (negative_ ? kSF_Negative : 0) |
+                (truncated_ ? kSF_Truncated : 0) |
+                (expSign_ < 0 ? kSF_ExpNegative : 0) |
+                (trailingSpaces_ ? kSF_TrailingSpace : 0) |
+                (intDigits_ ? kSF_IntDigits : 0) |
+                (fracDigits_ ? kSF_FracDigits : 0) |
+                (expDigits_ ? kSF_ExpDigits : 0) |
+                ((uint32_t)tailDigits_ << kSF_TailDigitsShift) |
+                ((uint32_t)expValue_ << kSF_ExpValueShift);
+            return saved;
+        }
+
+        void restore(const ReaderState& saved)
+        {
+            const uint32_t flags = saved.flags;
+
+            GoTo((eState)(flags & kSF_StateMask));
+            valid_ = (flags & kSF_Valid) != 0;
+
+            // leading zeros never reach the mantissa, so its length is
+            // the number of digits it has taken
+            negative_ = (flags & kSF_Negative) != 0;
+            mantissa_ = saved.digits;
+            mantissaDigits_ = CountDigits(mantissa_);
+            tail_ = saved.tail;
+            tailDigits_ = (flags >> kSF_TailDigitsShift) & 0x1f;
+            exp10Adjust_ = saved.exp10;
+            truncated_ = (flags & kSF_Truncated) != 0;
+            expSign_ = (flags & kSF_ExpNegative) ? -1 : 1;
+            expValue_ = (int)(flags >> kSF_ExpValueShift);
+
+            intDigits_ = (flags & kSF_IntDigits) ? 1 : 0;
+            fracDigits_ = (flags & kSF_FracDigits) ? 1 : 0;
+            expDigits_ = (flags & kSF_ExpDigits) ? 1 : 0;
+            trailingSpaces_ = (flags & kSF_TrailingSpace) ? 1 : 0;
         }
 
         eType type() const { return type_; }
-        double value() const { return sign_ * value_ * pow(10.0, expSign_ * expValue_); }
+        double value() const { return DecimalToDouble(decimal()); }
+        float floatValue() const { return DecimalToFloat(decimal()); }
+        long double longDoubleValue() const { return DecimalToLongDouble(decimal()); }
         bool valid() const { return valid_; }
-        double sign() const { return sign_; }
+        double sign() const { return negative_ ? -1.0 : 1.0; }
+
+        Decimal decimal() const
+        {
+            Decimal d;
+            d.mantissa = mantissa_;
+            d.tail = tail_;
+            d.tailDigits = tailDigits_;
+            d.exp10 = expSign_ * expValue_ + exp10Adjust_;
+            d.negative = negative_;
+            d.truncated = truncated_;
+            return d;
+        }
 
         int intDigits() const { return intDigits_; }
         int fracDigits() const { return fracDigits_; }
@@ -312,65 +461,63 @@ private:
 
     private:
 
-
-        void SetSign(bool neg) { neg ? sign_ = -1.0 : sign_ = 1.0; }
-        void SetExpSign(bool neg) { neg ? expSign_ = -1 : expSign_ = 1; }
-
-
-        State* state_;
-        bool valid_;
-        eType type_;
-
-        double sign_;
-        double value_;
-        double fracScale_;
-        int expSign_;
-        int expValue_;
-
-        int intDigits_;
-        int fracDigits_;
-        int expDigits_;
-        int trailingSpaces_;
-    };
-
-    struct State
-    {
-        virtual int put(CharType ch)
+        // 19 digits go to the mantissa, the next 19 to the tail, the rest
+        // only shift the exponent or mark the number as truncated
+        void AddSignificantDigit(int digit, bool fraction)
         {
-            assert(data_);
-            return 0;
+            if (mantissaDigits_ < 19)
+            {
+                if (mantissa_ || digit)
+                {
+                    mantissa_ = mantissa_ * 10 + digit;
+                    mantissaDigits_++;
+                }
+                if (fraction)
+                    exp10Adjust_--;
+            }
+            else if (tailDigits_ < 19)
+            {
+                tail_ = tail_ * 10 + digit;
+                tailDigits_++;
+                if (fraction)
+                    exp10Adjust_--;
+            }
+            else
+            {
+                if (digit)
+                    truncated_ = true;
+                if (!fraction)
+                    exp10Adjust_++;
+            }
         }
 
-    protected:
-        State(Data* data) : data_(data) { }
-
         void AddIntDigit(CharType ch)
         {
-            data_->value_ *= 10.0;
-            data_->value_ += (double)ToDigit(ch);
-            data_->intDigits_++;
+            AddSignificantDigit(ToDigit(ch), false);
+            intDigits_++;
         }
 
         void AddFracDigit(CharType ch)
         {
-            data_->value_ += ((double)ToDigit(ch)) * data_->fracScale_;
-            data_->fracScale_ *= 0.1;
-            data_->fracDigits_++;
+            AddSignificantDigit(ToDigit(ch), true);
+            fracDigits_++;
         }
 
         void AddExpDigit(CharType ch)
         {
-            data_->expValue_ *= 10;
-            data_->expValue_ += (int)ToDigit(ch);
-            data_->expDigits_++;
+            // anything longer is out of range for every type anyway, and
+            // the saturated value still fits a saved state
+            const int value = expValue_ * 10 + ToDigit(ch);
+            expValue_ = (value < kMaxExpValue) ? value : kMaxExpValue;
+            expDigits_++;
         }
 
         void SetSign(CharType ch)
         {
             switch(ch)
             {
-                case '-': data_->SetSign(true);  break;
-                case '+': data_->SetSign(false);  break;
+                case '-': negative_ = true;  break;
+                case '+': negative_ = false;  break;
                 default: break;
             }
         }
@@ -379,36 +526,21 @@ private:
         {
             switch(ch)
             {
-                case '-': data_->SetExpSign(true);  break;
-                case '+': data_->SetExpSign(false);  break;
+                case '-': expSign_ = -1;  break;
+                case '+': expSign_ = 1;  break;
                 default: break;
             }
         }
 
-        void SetValid() { data_->valid_ = true; }
-        void SetInvalid() { data_->valid_ = false; }
-
-        void ResetFracScale() { data_->fracScale_ = 0.1; }
-
-        Data* data_;
-    };
-
-    DoubleReaderImpl();
-
-public:
-    ~DoubleReaderImpl();
-    static DoubleReaderImpl* Instance();
-
-    //-----------------------------------------------------------------------------
+        void SetValid() { valid_ = true; }
+        void SetInvalid() { valid_ = false; }
 
-    struct InitState : public State
-    {
-        InitState(Data* data) : State(data) {}
+        void AddTrailingSpace() { trailingSpaces_++; }
 
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kInitState
+        int PutInit(CharType ch)
         {
-            State::put(ch);
-
             if (isSpace(ch))
             {
                 return 1;
@@ -418,96 +550,79 @@ public:
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
             if (kCC_Sign == charClass)
             {
                 SetSign(ch);
-                data_->GoTo(kWaitIDP_State);
+                GoTo(kWaitIDP_State);
                 return 1;
             }
 
             if (kCC_Digit == charClass)
             {
                 AddIntDigit(ch);
-                data_->GoTo(kWaitIDPE_State);
+                GoTo(kWaitIDPE_State);
                 return 1;
             }
 
             if (kCC_Point == charClass)
             {
-                ResetFracScale();
-                data_->GoTo(kWaitFD_State);
+                GoTo(kWaitFD_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // InitState class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitIDP_State : public State
-    {
-        WaitIDP_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitIDP_State
+        int PutWaitIDP(CharType ch)
         {
-            State::put(ch);
-
             eCharClass charClass = GetCharClass(ch);
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
             if (kCC_Digit == charClass)
             {
                 AddIntDigit(ch);
-                data_->GoTo(kWaitIDPE_State);
+                GoTo(kWaitIDPE_State);
                 return 1;
             }
 
             if (kCC_Point == charClass)
             {
-                if (data_->intDigits() > 0)
+                if (intDigits() > 0)
                 {
                     SetValid();
-                    data_->GoTo(kWaitFDES_State);
+                    GoTo(kWaitFDES_State);
+                    return 1;
                 }
 
-                ResetFracScale();
-                data_->GoTo(kWaitFD_State);
+                GoTo(kWaitFD_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitIDP_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitIDPE_State : public State
-    {
-        WaitIDPE_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitIDPE_State
+        int PutWaitIDPE(CharType ch)
         {
-            State::put(ch);
-
             eCharClass charClass = GetCharClass(ch);
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -519,45 +634,37 @@ public:
 
             if (kCC_Point == charClass)
             {
-                if (data_->intDigits() > 0)
+                if (intDigits() > 0)
                 {
                     SetValid();
-                    data_->GoTo(kWaitFDES_State);
+                    GoTo(kWaitFDES_State);
+                    return 1;
                 }
 
-                ResetFracScale();
-                data_->GoTo(kWaitFD_State);
+                GoTo(kWaitFD_State);
                 return 1;
             }
 
             if (kCC_Exp == charClass)
             {
                 SetInvalid();
-                data_->GoTo(kWaitESD_State);
+                GoTo(kWaitESD_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitIDPE_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitFD_State : public State
-    {
-        WaitFD_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitFD_State
+        int PutWaitFD(CharType ch)
         {
-            State::put(ch);
-
             eCharClass charClass = GetCharClass(ch);
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -565,34 +672,27 @@ public:
             {
                 AddFracDigit(ch);
                 SetValid();
-                data_->GoTo(kWaitFDES_State);
+                GoTo(kWaitFDES_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitFD_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitFDES_State : public State
-    {
-        WaitFDES_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitFDES_State
+        int PutWaitFDES(CharType ch)
         {
-            State::put(ch);
-
-            if (isSpace(ch) && data_->valid())
+            if (isSpace(ch) && valid())
             {
+                AddTrailingSpace();
                 return 1;
             }
 
-            if (data_->trailingSpaces() > 0)
+            if (trailingSpaces() > 0)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -600,7 +700,7 @@ public:
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -613,38 +713,30 @@ public:
             if (kCC_Exp == charClass)
             {
                 SetInvalid();
-                data_->GoTo(kWaitESD_State);
+                GoTo(kWaitESD_State);
                 return 1;
             }
 
-            if ((kCC_SuffixF == charClass && data_->type() == kFloat) ||
-                (kCC_SuffixLD == charClass && data_->type() == kLongDouble))
+            if ((kCC_SuffixF == charClass && type() == kFloat) ||
+                (kCC_SuffixLD == charClass && type() == kLongDouble))
             {
-                data_->GoTo(kWaitTS_State);
+                GoTo(kWaitTS_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitFDES_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitESD_State : public State
-    {
-        WaitESD_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitESD_State
+        int PutWaitESD(CharType ch)
         {
-            State::put(ch);
-
             eCharClass charClass = GetCharClass(ch);
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -652,7 +744,7 @@ public:
             {
                 SetExpSign(ch);
 
-                data_->GoTo(kWaitEDS_State);
+                GoTo(kWaitEDS_State);
                 return 1;
             }
 
@@ -660,34 +752,27 @@ public:
             {
                 AddExpDigit(ch);
                 SetValid();
-                data_->GoTo(kWaitEDS_State);
+                GoTo(kWaitEDS_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitESD_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitEDS_State : public State
-    {
-        WaitEDS_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitEDS_State
+        int PutWaitEDS(CharType ch)
         {
-            State::put(ch);
-
-            if (isSpace(ch) && data_->valid())
+            if (isSpace(ch) && valid())
             {
+                AddTrailingSpace();
                 return 1;
             }
 
-            if (data_->trailingSpaces() > 0)
+            if (trailingSpaces() > 0)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -695,7 +780,7 @@ public:
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -706,73 +791,71 @@ public:
                 return 1;
             }
 
-            if ((kCC_SuffixF == charClass && data_->type() == kFloat) ||
-                (kCC_SuffixLD == charClass && data_->type() == kLongDouble))
+            if ((kCC_SuffixF == charClass && type() == kFloat) ||
+                (kCC_SuffixLD == charClass && type() == kLongDouble))
             {
-                data_->GoTo(kWaitTS_State);
+                GoTo(kWaitTS_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitEDS_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitTS_State : public State
-    {
-        WaitTS_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitTS_State
+        int PutWaitTS(CharType ch)
         {
-            State::put(ch);
-
-            if (isSpace(ch) && data_->valid())
+            if (isSpace(ch) && valid())
             {
+                AddTrailingSpace();
                 return 1;
             }
 
-            if (data_->trailingSpaces() > 0)
+            if (trailingSpaces() > 0)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
+
+        //---------------------------------------------------------------------
+        eState stateId_;
+        bool valid_;
+        eType type_;
+
+        bool negative_;
+        uint64_t mantissa_;
+        int mantissaDigits_;
+        uint64_t tail_;
+        int tailDigits_;
+        int exp10Adjust_;
+        bool truncated_;
+        int expSign_;
+        int expValue_;
 
-        } // put()
-    }; // WaitTS_State class
+        int intDigits_;
+        int fracDigits_;
+        int expDigits_;
+        int trailingSpaces_;
+    };
+
+    DoubleReaderImpl();
+
+public:
+    ~DoubleReaderImpl();
+    static DoubleReaderImpl* Instance();
 
     template<typename T>
     Data* data(T = 0);
 
 private:
-    InitState        *initState_;
-    WaitIDP_State    *waitIDP_State_;
-    WaitIDPE_State   *waitIDPE_State_;
-    WaitFD_State     *waitFD_State_;
-    WaitFDES_State   *waitFDES_State_;
-    WaitESD_State    *waitESD_State_;
-    WaitEDS_State    *waitEDS_State_;
-    WaitTS_State     *waitTS_State_;
-
     Data data_;
 
-    ByteType initStateMemory_       [sizeof(InitState)];
-    ByteType waitIDP_StateMemory_   [sizeof(WaitIDP_State)];
-    ByteType waitIDPE_StateMemory_  [sizeof(WaitIDPE_State)];
-    ByteType waitFD_tateMemory_     [sizeof(WaitFD_State)];
-    ByteType waitFDES_StateMemory_  [sizeof(WaitFDES_State)];
-    ByteType waitESD_StateMemory_   [sizeof(WaitESD_State)];
-    ByteType waitEDS_StateMemory_   [sizeof(WaitEDS_State)];
-    ByteType waitTS_StateMemory_    [sizeof(WaitTS_State)];
-
-    State* states_[kStateCount];
-
-    static DoubleReaderImpl* sInstance_;
+    static FNR_THREAD_LOCAL DoubleReaderImpl* sInstance_;
 
 };
 
@@ -787,12 +870,12 @@ template<>
 DoubleReaderImpl::Data* DoubleReaderImpl::data(long double) { data_.setType(kLongDouble); return &data_; }
 
 //-----------------------------------------------------------------------------
-DoubleReaderImpl* DoubleReaderImpl::sInstance_ = 0;
+FNR_THREAD_LOCAL DoubleReaderImpl* DoubleReaderImpl::sInstance_ = 0;
 
 //-----------------------------------------------------------------------------
 DoubleReaderImpl* DoubleReaderImpl::Instance()
 {
-    static ByteType instanceMemory[sizeof(DoubleReaderImpl)];
+    static FNR_THREAD_LOCAL ByteType instanceMemory[sizeof(DoubleReaderImpl)];
     if (!sInstance_)
     {
         sInstance_ = new (&instanceMemory[0]) DoubleReaderImpl();
@@ -804,24 +887,6 @@ DoubleReaderImpl::DoubleReaderImpl()
 {
     assert(!sInstance_);
     sInstance_ = this;
-
-    initState_          = new (&initStateMemory_[0])        InitState(data<double>());
-    waitIDP_State_      = new (&waitIDP_StateMemory_[0])    WaitIDP_State(data<double>());
-    waitIDPE_State_     = new (&waitIDPE_StateMemory_[0])   WaitIDPE_State(data<double>());
-    waitFD_State_       = new (&waitFD_tateMemory_[0])      WaitFD_State(data<double>());
-    waitFDES_State_     = new (&waitFDES_StateMemory_[0])    WaitFDES_State(data<double>());
-    waitESD_State_      = new (&waitESD_StateMemory_[0])    WaitESD_State(data<double>());
-    waitEDS_State_      = new (&waitEDS_StateMemory_[0])     WaitEDS_State(data<double>());
-    waitTS_State_       = new (&waitTS_StateMemory_[0])     WaitTS_State(data<double>());
-
-    states_[kInitState]         = initState_;
-    states_[kWaitIDP_State]     = waitIDP_State_;
-    states_[kWaitIDPE_State]    = waitIDPE_State_;
-    states_[kWaitFD_State]      = waitFD_State_;
-    states_[kWaitFDES_State]    = waitFDES_State_;
-    states_[kWaitESD_State]     = waitESD_State_;
-    states_[kWaitEDS_State]     = waitEDS_State_;
-    states_[kWaitTS_State]      = waitTS_State_;
 }
 
 //-----------------------------------------------------------------------------
@@ -830,11 +895,6 @@ DoubleReaderImpl::~DoubleReaderImpl()
 {
     sInstance_ = 0;
 }
-//-----------------------------------------------------------------------------
-DoubleReaderImpl::State* DoubleReaderImpl::GetState(DoubleReaderImpl::eState state)
-{
-    return DoubleReaderImpl::Instance()->states_[state];
-}
 
 //*****************************************************************************
 // NumberReader<double>
@@ -842,7 +902,7 @@ DoubleReaderImpl::State* DoubleReaderImpl::GetState(DoubleReaderImpl::eState sta
 
 //-----------------------------------------------------------------------------
 
-NumberReader<double>::NumberReader() : impl_(DoubleReaderImpl::Instance())
+NumberReader<double>::NumberReader()
 {
 
 }
@@ -850,27 +910,55 @@ NumberReader<double>::NumberReader() : impl_(DoubleReaderImpl::Instance())
 //-----------------------------------------------------------------------------
 NumberReader<double>::~NumberReader()
 {
-    impl_->data<double>()->reset();
+    DoubleReaderImpl::Instance()->data<double>()->reset();
 }
 //-----------------------------------------------------------------------------
 
 int NumberReader<double>::put(CharType ch)
 {
-    return impl_->data<double>()->put(ch);
+    return DoubleReaderImpl::Instance()->data<double>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<double>::read(const CharType* str, size_t length)
+{
+    return DoubleReaderImpl::Instance()->data<double>()->read(str, length);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<double>::readWithIntegers(const CharType* str, size_t length)
+{
+    return DoubleReaderImpl::Instance()->data<double>()->read(str, length, true);
 }
 
 //-----------------------------------------------------------------------------
 
 double NumberReader<double>::value() const
 {
-    return impl_->data<double>()->value();
+    return DoubleReaderImpl::Instance()->data<double>()->value();
 }
 
 //-----------------------------------------------------------------------------
 
 bool NumberReader<double>::valid() const
 {
-    return impl_->data<double>()->valid();
+    return DoubleReaderImpl::Instance()->data<double>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<double>::save() const
+{
+    return DoubleReaderImpl::Instance()->data<double>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<double>::restore(const ReaderState& state)
+{
+    DoubleReaderImpl::Instance()->data<double>()->restore(state);
 }
 
 //*****************************************************************************
@@ -879,7 +967,7 @@ bool NumberReader<double>::valid() const
 
 //-----------------------------------------------------------------------------
 
-NumberReader<float>::NumberReader() : impl_(DoubleReaderImpl::Instance())
+NumberReader<float>::NumberReader()
 {
 
 }
@@ -887,27 +975,55 @@ NumberReader<float>::NumberReader() : impl_(DoubleReaderImpl::Instance())
 //-----------------------------------------------------------------------------
 NumberReader<float>::~NumberReader()
 {
-    impl_->data<float>()->reset();
+    DoubleReaderImpl::Instance()->data<float>()->reset();
 }
 //-----------------------------------------------------------------------------
 
 int NumberReader<float>::put(CharType ch)
 {
-    return impl_->data<float>()->put(ch);
+    return DoubleReaderImpl::Instance()->data<float>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<float>::read(const CharType* str, size_t length)
+{
+    return DoubleReaderImpl::Instance()->data<float>()->read(str, length);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<float>::readWithIntegers(const CharType* str, size_t length)
+{
+    return DoubleReaderImpl::Instance()->data<float>()->read(str, length, true);
 }
 
 //-----------------------------------------------------------------------------
 
 float NumberReader<float>::value() const
 {
-    return (float)impl_->data<float>()->value();
+    return DoubleReaderImpl::Instance()->data<float>()->floatValue();
 }
 
 //-----------------------------------------------------------------------------
 
 bool NumberReader<float>::valid() const
 {
-    return impl_->data<float>()->valid();
+    return DoubleReaderImpl::Instance()->data<float>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<float>::save() const
+{
+    return DoubleReaderImpl::Instance()->data<float>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<float>::restore(const ReaderState& state)
+{
+    DoubleReaderImpl::Instance()->data<float>()->restore(state);
 }
 
 //*****************************************************************************
@@ -916,7 +1032,7 @@ bool NumberReader<float>::valid() const
 
 //-----------------------------------------------------------------------------
 
-NumberReader<long double>::NumberReader() : impl_(DoubleReaderImpl::Instance())
+NumberReader<long double>::NumberReader()
 {
 
 }
@@ -924,32 +1040,69 @@ NumberReader<long double>::NumberReader() : impl_(DoubleReaderImpl::Instance())
 //-----------------------------------------------------------------------------
 NumberReader<long double>::~NumberReader()
 {
-    impl_->data<long double>()->reset();
+    DoubleReaderImpl::Instance()->data<long double>()->reset();
 }
 //-----------------------------------------------------------------------------
 
 int NumberReader<long double>::put(CharType ch)
 {
-    return impl_->data<long double>()->put(ch);
+    return DoubleReaderImpl::Instance()->data<long double>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<long double>::read(const CharType* str, size_t length)
+{
+    return DoubleReaderImpl::Instance()->data<long double>()->read(str, length);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<long double>::readWithIntegers(const CharType* str, size_t length)
+{
+    return DoubleReaderImpl::Instance()->data<long double>()->read(str, length, true);
 }
 
 //-----------------------------------------------------------------------------
 
 long double NumberReader<long double>::value() const
 {
-    return impl_->data<long double>()->value();
+    return DoubleReaderImpl::Instance()->data<long double>()->longDoubleValue();
 }
 
 //-----------------------------------------------------------------------------
 
 bool NumberReader<long double>::valid() const
 {
-    return impl_->data<long double>()->valid();
+    return DoubleReaderImpl::Instance()->data<long double>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<long double>::save() const
+{
+    return DoubleReaderImpl::Instance()->data<long double>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<long double>::restore(const ReaderState& state)
+{
+    DoubleReaderImpl::Instance()->data<long double>()->restore(state);
 }
 
 //*****************************************************************************
 // IntegerReaderImpl
 //*****************************************************************************
+//-----------------------------------------------------------------------------
+// Limits of the integer types, in the order of IntegerReaderImpl::eType:
+// the largest decimal magnitude (one more if negative) and the hex bits.
+static const uint64_t kMaxValue[] = { LONG_MAX, INT_MAX, SHRT_MAX, LLONG_MAX };
+static const uint64_t kMaxBits[] = { ULONG_MAX, UINT_MAX, USHRT_MAX, ULLONG_MAX };
+
+// any magnitude up to this takes one more decimal digit without wrapping
+static const uint64_t kMaxDecimalStep = (UINT64_MAX - 9) / 10;
+
 //-----------------------------------------------------------------------------
 class IntegerReaderImpl
 {
@@ -960,6 +1113,7 @@ public:
         kLong,
         kInt,
         kShort,
+        kLongLong,
     };
 
     enum eState
@@ -975,26 +1129,20 @@ public:
 
 private:
 
-    struct State;
-
-    static State* GetState(eState state);
-
     struct Data
     {
-        friend struct State;
-
-        Data() : state_(0), type_(kLong)
+        Data() : type_(kLong)
         {
             reset();
         }
 
         void reset()
         {
-            state_ = 0;
+            stateId_ = kInitState;
             valid_ = false;
 
-            sign_ = 1;
-            value_ = 0;
+            negative_ = false;
+            magnitude_ = 0;
 
             intDigits_ = 0;
             hexDigits_ = 0;
@@ -1009,106 +1157,196 @@ private:
 
         int put(CharType ch)
         {
-            if (!state_)
-                GoTo(kInitState);
-            return state_->put(ch);
+            // a switch over the state id, no virtual call or state lookup
+            switch (stateId_)
+            {
+                case kInitState:     return PutInit(ch);
+                case kWaitIDZ_State: return PutWaitIDZ(ch);
+                case kWaitIDS_State: return PutWaitIDS(ch);
+                case kWaitH_State:   return PutWaitH(ch);
+                case kWaitHDS_State: return PutWaitHDS(ch);
+                case kWaitTS_State:  return PutWaitTS(ch);
+                default: break;
+            }
+            return 0;
         }
 
-        void GoTo(eState state)
+        // The grammar of put() in one pass, with no state dispatch per char.
+        // An integer is valid from its first digit on, so the only prefix
+        // ever given back is the "0" of a "0x" without hex digits.
+        size_t read(const CharType* str, size_t length)
         {
-            state_ = GetState(state);
-        }
-
-        eType type() const { return type_; }
-        long value() const{ return sign_ * value_; }
-        bool valid() const { return valid_; }
-        long sign() const { return sign_; }
+            reset();
 
-        int intDigits() const { return intDigits_; }
-        int hexDigits() const { return hexDigits_; }
-        int trailingSpaces() const { return trailingSpaces_; }
+            // leading padding is skipped in bulk, and the first space after
+            // the number ends it: trailing spaces never extend the prefix
+            const CharType* end = str + length;
+            const CharType* p = SkipSpaces(str, end);
 
-    private:
+            if (p < end && (*p == '-' || *p == '+'))
+                SetSign(*p++);
+            if (p == end || !IsDigit(*p))
+            {
+                reset();
+                return 0;
+            }
 
-        void SetSign(bool neg) { neg ? sign_ = -1L : sign_ = 1L; }
+            if (*p != '0')
+            {
+                // out of range is no number, not a shorter one
+                for (; p < end && IsDigit(*p); ++p)
+                {
+                    if (!AddIntDigit(*p))
+                    {
+                        reset();
+                        return 0;
+                    }
+                }
+                GoTo(kWaitIDS_State);
+            }
+            else if (end - p > 2 && (p[1] == 'x' || p[1] == 'X'))
+            {
+                // hex digits go in bulk, 8 or 16 per step, as many as fit
+                // 64 bits; past them only leading zeros keep it in range
+                const CharType* digits = p + 2;
+                const CharType* runEnd = (end - digits > 16) ? digits + 16 : end;
+                uint64_t bits = 0;
+                const size_t run = DecodeHexRun(digits, runEnd, bits);
+                magnitude_ = bits;
+                hexDigits_ = (int)run;
+                p = run ? digits + run : p + 1;
+                if (magnitude_ > kMaxBits[type_])
+                {
+                    reset();
+                    return 0;
+                }
 
+                for (; run && p < end; ++p)
+                {
+                    uint64_t digit = 0;
+                    if (!DecodeHexRun(p, p + 1, digit))
+                        break;
+                    if (!AddHexDigitValue((int)digit))
+                    {
+                        reset();
+                        return 0;
+                    }
+                }
+                GoTo(run ? kWaitHDS_State : kWaitH_State);
+            }
+            else
+            {
+                ++p;
+                GoTo(kWaitH_State);
+            }
 
-        State* state_;
-        bool valid_;
-        eType type_;
+            if (p < end && (*p == 'l' || *p == 'L'))
+            {
+                ++p;
+                GoTo(kWaitTS_State);
+            }
 
-        long sign_;
-        long value_;
+            SetValid();
+            return p - str;
+        }
 
-        int intDigits_;
-        int hexDigits_;
-        int trailingSpaces_;
-    };
+        void GoTo(eState state)
+        {
+            stateId_ = state;
+        }
 
-    struct State
-    {
-        virtual int put(CharType ch)
+        ReaderState save() const
         {
-            assert(data_);
-            return 0;
+            ReaderState saved;
+            saved.digits = magnitude_;
+            saved.tail = 0;
+            saved.exp10 = 0;
+            saved.flags = (uint32_t)stateId_ |
+                (valid_ ? kSF_Valid : 0) |
+                (negative_ ? kSF_Negative : 0) |
+                (trailingSpaces_ ? kSF_TrailingSpace : 0) |
+                (intDigits_ ? kSF_IntDigits : 0) |
+                (hexDigits_ ? kSF_HexDigits : 0);
+            return saved;
         }
 
-    protected:
-        State(Data* data) : data_(data) { }
+        void restore(const ReaderState& saved)
+        {
+            const uint32_t flags = saved.flags;
 
-        void AddIntDigit(CharType ch)
+            GoTo((eState)(flags & kSF_StateMask));
+            valid_ = (flags & kSF_Valid) != 0;
+
+            negative_ = (flags & kSF_Negative) != 0;
+            magnitude_ = saved.digits;
+
+            intDigits_ = (flags & kSF_IntDigits) ? 1 : 0;
+            hexDigits_ = (flags & kSF_HexDigits) ? 1 : 0;
+            trailingSpaces_ = (flags & kSF_TrailingSpace) ? 1 : 0;
+        }
+
+        eType type() const { return type_; }
+        // negated in unsigned arithmetic, the most negative value has no
+        // positive counterpart; hex past the signed range keeps its bits
+        long long value() const
         {
-            data_->value_ *= 10;
-            data_->value_ += (long)ToDigit(ch);
-            data_->intDigits_++;
+            return (long long)(negative_ ? 0 - magnitude_ : magnitude_);
         }
+        bool valid() const { return valid_; }
+        long sign() const { return negative_ ? -1L : 1L; }
+
+        int intDigits() const { return intDigits_; }
+        int hexDigits() const { return hexDigits_; }
+        int trailingSpaces() const { return trailingSpaces_; }
+
+    private:
 
-        void AddIntDigitAsHex(CharType ch)
+        // The magnitude is checked against the type before every digit:
+        // decimal numbers keep to the signed range, hex ones may fill all
+        // the bits of the type. A digit that does not fit returns false.
+        bool AddIntDigit(CharType ch)
         {
-            data_->value_ *= 16;
-            data_->value_ += (long)ToDigit(ch);
-            data_->hexDigits_++;
+            const uint64_t digit = (uint64_t)ToDigit(ch);
+            if (magnitude_ > kMaxDecimalStep)
+                return false;
+            magnitude_ = magnitude_ * 10 + digit;
+            if (magnitude_ > kMaxValue[type_] + (negative_ ? 1 : 0))
+                return false;
+            intDigits_++;
+            return true;
         }
 
-        void AddHexDigit(CharType ch)
+        bool AddHexDigitValue(int digit)
         {
-            data_->value_ *= 16;
-            data_->value_ += (long)ToHexDigit(ch);
-            data_->hexDigits_++;
+            if (magnitude_ > (kMaxBits[type_] >> 4))
+                return false;
+            magnitude_ = magnitude_ * 16 + (uint64_t)digit;
+            hexDigits_++;
+            return true;
         }
 
+        bool AddIntDigitAsHex(CharType ch) { return AddHexDigitValue(ToDigit(ch)); }
+        bool AddHexDigit(CharType ch) { return AddHexDigitValue(ToHexDigit(ch)); }
+
         void SetSign(CharType ch)
         {
             switch(ch)
             {
-                case '-': data_->SetSign(true);  break;
-                case '+': data_->SetSign(false);  break;
+                case '-': negative_ = true;  break;
+                case '+': negative_ = false;  break;
                 default: break;
             }
         }
 
-        void SetValid() { data_->valid_ = true; }
-        void SetInvalid() { data_->valid_ = false; }
-
-        Data* data_;
-    };
-
-    IntegerReaderImpl();
-
-public:
-    ~IntegerReaderImpl();
-    static IntegerReaderImpl* Instance();
-
-    //-----------------------------------------------------------------------------
+        void SetValid() { valid_ = true; }
+        void SetInvalid() { valid_ = false; }
 
-    struct InitState : public State
-    {
-        InitState(Data* data) : State(data) {}
+        void AddTrailingSpace() { trailingSpaces_++; }
 
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kInitState
+        int PutInit(CharType ch)
         {
-            State::put(ch);
-
             if (isSpace(ch))
             {
                 return 1;
@@ -1118,14 +1356,14 @@ public:
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
             if (kCC_Sign == charClass)
             {
                 SetSign(ch);
-                data_->GoTo(kWaitIDZ_State);
+                GoTo(kWaitIDZ_State);
                 return 1;
             }
 
@@ -1133,38 +1371,32 @@ public:
             {
                 if (ch != '0')
                 {
-                    AddIntDigit(ch);
+                    AddIntDigit(ch);    // one digit always fits
                     SetValid();
-                    data_->GoTo(kWaitIDS_State);
+                    GoTo(kWaitIDS_State);
                 }
                 else
                 {
-                    data_->GoTo(kWaitH_State);
+                    // a lone 0, or the start of "0x"
+                    SetValid();
+                    GoTo(kWaitH_State);
                 }
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // InitState class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitIDZ_State : public State
-    {
-        WaitIDZ_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitIDZ_State
+        int PutWaitIDZ(CharType ch)
         {
-            State::put(ch);
-
             eCharClass charClass = GetCharClass(ch);
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -1172,42 +1404,37 @@ public:
             {
                 if (ch != '0')
                 {
-                    AddIntDigit(ch);
+                    AddIntDigit(ch);    // one digit always fits
                     SetValid();
-                    data_->GoTo(kWaitIDS_State);
+                    GoTo(kWaitIDS_State);
                 }
                 else
                 {
-                    data_->GoTo(kWaitH_State);
+                    // a lone 0, or the start of "0x"
+                    SetValid();
+                    GoTo(kWaitH_State);
                 }
 
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitIDZ_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitIDS_State : public State
-    {
-        WaitIDS_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitIDS_State
+        int PutWaitIDS(CharType ch)
         {
-            State::put(ch);
-
-            if (isSpace(ch) && data_->valid())
+            if (isSpace(ch) && valid())
             {
+                AddTrailingSpace();
                 return 1;
             }
 
-            if (data_->trailingSpaces() > 0)
+            if (trailingSpaces() > 0)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -1215,76 +1442,85 @@ public:
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
             if (kCC_Digit == charClass)
             {
-                AddIntDigit(ch);
+                if (!AddIntDigit(ch))
+                {
+                    reset();
+                    return 0;
+                }
                 return 1;
             }
 
             if (kCC_SuffixLD == charClass)
             {
-                data_->GoTo(kWaitTS_State);
+                GoTo(kWaitTS_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitIDS_State class
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitH_State : public State
-    {
-        WaitH_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitH_State
+        int PutWaitH(CharType ch)
         {
-            State::put(ch);
+            if (isSpace(ch) && valid())
+            {
+                AddTrailingSpace();
+                return 1;
+            }
+
+            if (trailingSpaces() > 0)
+            {
+                reset();
+                return 0;
+            }
 
             eCharClass charClass = GetCharClass(ch);
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
             if (kCC_Hex == charClass)
             {
-                data_->GoTo(kWaitHDS_State);
+                // "0x" alone is no number
+                SetInvalid();
+                GoTo(kWaitHDS_State);
                 return 1;
             }
 
-            data_->reset();
-            return 0;
-
-        } // put()
-    }; // WaitH_State class
-
-    //-----------------------------------------------------------------------------
+            if (kCC_SuffixLD == charClass)
+            {
+                GoTo(kWaitTS_State);
+                return 1;
+            }
 
-    struct WaitHDS_State : public State
-    {
-        WaitHDS_State(Data* data) : State(data) {}
+            reset();
+            return 0;
+        }
 
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitHDS_State
+        int PutWaitHDS(CharType ch)
         {
-            State::put(ch);
-
-            if (isSpace(ch) && data_->valid())
+            if (isSpace(ch) && valid())
             {
+                AddTrailingSpace();
                 return 1;
             }
 
-            if (data_->trailingSpaces() > 0)
+            if (trailingSpaces() > 0)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
@@ -1292,87 +1528,89 @@ public:
 
             if (kCC_None == charClass)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
             if (kCC_Digit == charClass)
             {
-                AddIntDigitAsHex(ch);
+                if (!AddIntDigitAsHex(ch))
+                {
+                    reset();
+                    return 0;
+                }
                 SetValid();
                 return 1;
             }
 
             if (kCC_HexDigit == charClass)
             {
-                AddHexDigit(ch);
+                if (!AddHexDigit(ch))
+                {
+                    reset();
+                    return 0;
+                }
                 SetValid();
                 return 1;
             }
 
             if (kCC_SuffixLD == charClass)
             {
-                data_->GoTo(kWaitTS_State);
+                GoTo(kWaitTS_State);
                 return 1;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
 
-        } // put()
-    }; // WaitHDS_State class
-
-
-    //-----------------------------------------------------------------------------
-
-    struct WaitTS_State : public State
-    {
-        WaitTS_State(Data* data) : State(data) {}
-
-        int put(CharType ch)
+        //---------------------------------------------------------------------
+        // kWaitTS_State
+        int PutWaitTS(CharType ch)
         {
-            State::put(ch);
-
-            if (isSpace(ch) && data_->valid())
+            if (isSpace(ch) && valid())
             {
+                AddTrailingSpace();
                 return 1;
             }
 
-            if (data_->trailingSpaces() > 0)
+            if (trailingSpaces() > 0)
             {
-                data_->reset();
+                reset();
                 return 0;
             }
 
-            data_->reset();
+            reset();
             return 0;
+        }
+
+        //---------------------------------------------------------------------
+        eState stateId_;
+        bool valid_;
+        eType type_;
+
+        bool negative_;
+        uint64_t magnitude_;
+
+        int intDigits_;
+        int hexDigits_;
+        int trailingSpaces_;
+    };
+
+    IntegerReaderImpl();
+
+public:
+    ~IntegerReaderImpl();
+    static IntegerReaderImpl* Instance();
 
-        } // put()
-    }; // WaitTS_State class
 
     template<typename T>
     Data* data(T = 0);
 
 private:
-    InitState       *initState_;
-    WaitIDZ_State   *waitIDZ_State_;
-    WaitIDS_State   *waitIDS_State_;
-    WaitH_State     *waitH_State_;
-    WaitHDS_State   *waitHDS_State_;
-    WaitTS_State    *waitTS_State_;
-
     Data data_;
 
-    ByteType initStateMemory_       [sizeof(InitState)];
-    ByteType waitIDZ_StateMemory_   [sizeof(WaitIDZ_State)];
-    ByteType waitIDS_StateMemory_   [sizeof(WaitIDS_State)];
-    ByteType waitH_tateMemory_      [sizeof(WaitH_State)];
-    ByteType waitHDS_StateMemory_   [sizeof(WaitHDS_State)];
-    ByteType waitTS_StateMemory_    [sizeof(WaitTS_State)];
-
-    State* states_[kStateCount];
-
-    static IntegerReaderImpl* sInstance_;
+    static FNR_THREAD_LOCAL IntegerReaderImpl* sInstance_;
 
 };
 
@@ -1386,13 +1624,16 @@ IntegerReaderImpl::Data* IntegerReaderImpl::data(int) { data_.setType(kInt); ret
 template<>
 IntegerReaderImpl::Data* IntegerReaderImpl::data(short) { data_.setType(kShort); return &data_; }
 
+template<>
+IntegerReaderImpl::Data* IntegerReaderImpl::data(long long) { data_.setType(kLongLong); return &data_; }
+
 //-----------------------------------------------------------------------------
-IntegerReaderImpl* IntegerReaderImpl::sInstance_ = 0;
+FNR_THREAD_LOCAL IntegerReaderImpl* IntegerReaderImpl::sInstance_ = 0;
 
 //-----------------------------------------------------------------------------
 IntegerReaderImpl* IntegerReaderImpl::Instance()
 {
-    static ByteType instanceMemory[sizeof(IntegerReaderImpl)];
+    static FNR_THREAD_LOCAL ByteType instanceMemory[sizeof(IntegerReaderImpl)];
     if (!sInstance_)
     {
         sInstance_ = new (&instanceMemory[0]) IntegerReaderImpl();
@@ -1404,20 +1645,6 @@ IntegerReaderImpl::IntegerReaderImpl()
 {
     assert(!sInstance_);
     sInstance_ = this;
-
-    initState_          = new (&initStateMemory_[0])        InitState(data<long>());
-    waitIDZ_State_      = new (&waitIDZ_StateMemory_[0])    WaitIDZ_State(data<long>());
-    waitIDS_State_      = new (&waitIDS_StateMemory_[0])    WaitIDS_State(data<long>());
-    waitH_State_        = new (&waitH_tateMemory_[0])       WaitH_State(data<long>());
-    waitHDS_State_      = new (&waitHDS_StateMemory_[0])    WaitHDS_State(data<long>());
-    waitTS_State_       = new (&waitTS_StateMemory_[0])     WaitTS_State(data<long>());
-
-    states_[kInitState]         = initState_;
-    states_[kWaitIDZ_State]     = waitIDZ_State_;
-    states_[kWaitIDS_State]     = waitIDS_State_;
-    states_[kWaitH_State]       = waitH_State_;
-    states_[kWaitHDS_State]     = waitHDS_State_;
-    states_[kWaitTS_State]      = waitTS_State_;
 }
 
 //-----------------------------------------------------------------------------
@@ -1426,11 +1653,6 @@ IntegerReaderImpl::~IntegerReaderImpl()
 {
     sInstance_ = 0;
 }
-//-----------------------------------------------------------------------------
-IntegerReaderImpl::State* IntegerReaderImpl::GetState(IntegerReaderImpl::eState state)
-{
-    return IntegerReaderImpl::Instance()->states_[state];
-}
 
 //*****************************************************************************
 // NumberReader<long>
@@ -1438,7 +1660,7 @@ IntegerReaderImpl::State* IntegerReaderImpl::GetState(IntegerReaderImpl::eState
 
 //-----------------------------------------------------------------------------
 
-NumberReader<long>::NumberReader() : impl_(IntegerReaderImpl::Instance())
+NumberReader<long>::NumberReader()
 {
 
 }
@@ -1446,27 +1668,48 @@ NumberReader<long>::NumberReader() : impl_(IntegerReaderImpl::Instance())
 //-----------------------------------------------------------------------------
 NumberReader<long>::~NumberReader()
 {
-    impl_->data<long>()->reset();
+    IntegerReaderImpl::Instance()->data<long>()->reset();
 }
 //-----------------------------------------------------------------------------
 
 int NumberReader<long>::put(CharType ch)
 {
-    return impl_->data<long>()->put(ch);
+    return IntegerReaderImpl::Instance()->data<long>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<long>::read(const CharType* str, size_t length)
+{
+    return IntegerReaderImpl::Instance()->data<long>()->read(str, length);
 }
 
 //-----------------------------------------------------------------------------
 
 long NumberReader<long>::value() const
 {
-    return impl_->data<long>()->value();
+    return (long)IntegerReaderImpl::Instance()->data<long>()->value();
 }
 
 //-----------------------------------------------------------------------------
 
 bool NumberReader<long>::valid() const
 {
-    return impl_->data<long>()->valid();
+    return IntegerReaderImpl::Instance()->data<long>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<long>::save() const
+{
+    return IntegerReaderImpl::Instance()->data<long>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<long>::restore(const ReaderState& state)
+{
+    IntegerReaderImpl::Instance()->data<long>()->restore(state);
 }
 
 //*****************************************************************************
@@ -1475,7 +1718,7 @@ bool NumberReader<long>::valid() const
 
 //-----------------------------------------------------------------------------
 
-NumberReader<int>::NumberReader() : impl_(IntegerReaderImpl::Instance())
+NumberReader<int>::NumberReader()
 {
 
 }
@@ -1483,27 +1726,48 @@ NumberReader<int>::NumberReader() : impl_(IntegerReaderImpl::Instance())
 //-----------------------------------------------------------------------------
 NumberReader<int>::~NumberReader()
 {
-    impl_->data<int>()->reset();
+    IntegerReaderImpl::Instance()->data<int>()->reset();
 }
 //-----------------------------------------------------------------------------
 
 int NumberReader<int>::put(CharType ch)
 {
-    return impl_->data<int>()->put(ch);
+    return IntegerReaderImpl::Instance()->data<int>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<int>::read(const CharType* str, size_t length)
+{
+    return IntegerReaderImpl::Instance()->data<int>()->read(str, length);
 }
 
 //-----------------------------------------------------------------------------
 
 int NumberReader<int>::value() const
 {
-    return impl_->data<int>()->value();
+    return (int)IntegerReaderImpl::Instance()->data<int>()->value();
 }
 
 //-----------------------------------------------------------------------------
 
 bool NumberReader<int>::valid() const
 {
-    return impl_->data<int>()->valid();
+    return IntegerReaderImpl::Instance()->data<int>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<int>::save() const
+{
+    return IntegerReaderImpl::Instance()->data<int>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<int>::restore(const ReaderState& state)
+{
+    IntegerReaderImpl::Instance()->data<int>()->restore(state);
 }
 
 //*****************************************************************************
@@ -1512,7 +1776,7 @@ bool NumberReader<int>::valid() const
 
 //-----------------------------------------------------------------------------
 
-NumberReader<short>::NumberReader() : impl_(IntegerReaderImpl::Instance())
+NumberReader<short>::NumberReader()
 {
 
 }
@@ -1520,26 +1784,105 @@ NumberReader<short>::NumberReader() : impl_(IntegerReaderImpl::Instance())
 //-----------------------------------------------------------------------------
 NumberReader<short>::~NumberReader()
 {
-    impl_->data<short>()->reset();
+    IntegerReaderImpl::Instance()->data<short>()->reset();
 }
 //-----------------------------------------------------------------------------
 
 int NumberReader<short>::put(CharType ch)
 {
-    return impl_->data<short>()->put(ch);
+    return IntegerReaderImpl::Instance()->data<short>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<short>::read(const CharType* str, size_t length)
+{
+    return IntegerReaderImpl::Instance()->data<short>()->read(str, length);
 }
 
 //-----------------------------------------------------------------------------
 
 short NumberReader<short>::value() const
 {
-    return (short)impl_->data<short>()->value();
+    return (short)IntegerReaderImpl::Instance()->data<short>()->value();
 }
 
 //-----------------------------------------------------------------------------
 
 bool NumberReader<short>::valid() const
 {
-    return impl_->data<short>()->valid();
+    return IntegerReaderImpl::Instance()->data<short>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<short>::save() const
+{
+    return IntegerReaderImpl::Instance()->data<short>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<short>::restore(const ReaderState& state)
+{
+    IntegerReaderImpl::Instance()->data<short>()->restore(state);
+}
+
+//*****************************************************************************
+// NumberReader<long long>
+//*****************************************************************************
+
+//-----------------------------------------------------------------------------
+
+NumberReader<long long>::NumberReader()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+NumberReader<long long>::~NumberReader()
+{
+    IntegerReaderImpl::Instance()->data<long long>()->reset();
+}
+//-----------------------------------------------------------------------------
+
+int NumberReader<long long>::put(CharType ch)
+{
+    return IntegerReaderImpl::Instance()->data<long long>()->put(ch);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t NumberReader<long long>::read(const CharType* str, size_t length)
+{
+    return IntegerReaderImpl::Instance()->data<long long>()->read(str, length);
+}
+
+//-----------------------------------------------------------------------------
+
+long long NumberReader<long long>::value() const
+{
+    return IntegerReaderImpl::Instance()->data<long long>()->value();
+}
+
+//-----------------------------------------------------------------------------
+
+bool NumberReader<long long>::valid() const
+{
+    return IntegerReaderImpl::Instance()->data<long long>()->valid();
+}
+
+//-----------------------------------------------------------------------------
+
+ReaderState NumberReader<long long>::save() const
+{
+    return IntegerReaderImpl::Instance()->data<long long>()->save();
+}
+
+//-----------------------------------------------------------------------------
+
+void NumberReader<long long>::restore(const ReaderState& state)
+{
+    IntegerReaderImpl::Instance()->data<long long>()->restore(state);
 }
 } // end of fnr
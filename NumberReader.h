@@ -35,13 +35,31 @@ SOFTWARE.
 #   include "Config.h"
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
 namespace fnr
 {
 
-class DoubleReaderImpl;
-
 //-----------------------------------------------------------------------------
+// Snapshot of a reader in the middle of a number. Plain data without
+// pointers: it can be copied, kept per connection or written out, and later
+// passed to restore() of a reader of the same type on any thread.
+struct ReaderState
+{
+    uint64_t digits;
+    uint64_t tail;
+    int32_t exp10;
+    uint32_t flags;
+};
+
+static_assert(sizeof(ReaderState) == 24, "ReaderState must stay compact");
 
+//-----------------------------------------------------------------------------
+// A reader keeps nothing of its own: every call works on the reader state
+// of the calling thread (FNR_THREAD_SAFE), so an object that owns a reader
+// may be used on any thread. A number read with put() over several calls
+// is continued on the same thread only, save() and restore() move it.
 template <typename T>
 class NumberReader;
 
@@ -54,13 +72,16 @@ public:
     NumberReader();
     ~NumberReader();
     int put(CharType ch);
+    // Reads the longest number prefix of str, returns chars consumed (0 if none).
+    size_t read(const CharType* str, size_t length);
+    // Same, but digits without a point or exponent ("42") are a number too,
+    // as CSV fields and free text are full of them.
+    size_t readWithIntegers(const CharType* str, size_t length);
     double value() const;
     bool valid() const;
-
-private:
-
-    DoubleReaderImpl* impl_;
-
+    // Saves the number read so far; put() continues it after restore().
+    ReaderState save() const;
+    void restore(const ReaderState& state);
 };
 
 //-----------------------------------------------------------------------------
@@ -72,13 +93,12 @@ public:
     NumberReader();
     ~NumberReader();
     int put(CharType ch);
+    size_t read(const CharType* str, size_t length);
+    size_t readWithIntegers(const CharType* str, size_t length);
     float value() const;
     bool valid() const;
-
-private:
-
-    DoubleReaderImpl* impl_;
-
+    ReaderState save() const;
+    void restore(const ReaderState& state);
 };
 
 //-----------------------------------------------------------------------------
@@ -90,18 +110,15 @@ public:
     NumberReader();
     ~NumberReader();
     int put(CharType ch);
+    size_t read(const CharType* str, size_t length);
+    size_t readWithIntegers(const CharType* str, size_t length);
     long double value() const;
     bool valid() const;
-
-private:
-
-    DoubleReaderImpl* impl_;
-
+    ReaderState save() const;
+    void restore(const ReaderState& state);
 };
 
 //*****************************************************************************
-class IntegerReaderImpl;
-
 //-----------------------------------------------------------------------------
 //
 template <>
@@ -111,13 +128,11 @@ public:
     NumberReader();
     ~NumberReader();
     int put(CharType ch);
+    size_t read(const CharType* str, size_t length);
     long value() const;
     bool valid() const;
-
-private:
-
-    IntegerReaderImpl* impl_;
-
+    ReaderState save() const;
+    void restore(const ReaderState& state);
 };
 
 //-----------------------------------------------------------------------------
@@ -129,13 +144,11 @@ public:
     NumberReader();
     ~NumberReader();
     int put(CharType ch);
+    size_t read(const CharType* str, size_t length);
     int value() const;
     bool valid() const;
-
-private:
-
-    IntegerReaderImpl* impl_;
-
+    ReaderState save() const;
+    void restore(const ReaderState& state);
 };
 
 //-----------------------------------------------------------------------------
@@ -147,13 +160,27 @@ public:
     NumberReader();
     ~NumberReader();
     int put(CharType ch);
+    size_t read(const CharType* str, size_t length);
     short value() const;
     bool valid() const;
+    ReaderState save() const;
+    void restore(const ReaderState& state);
+};
 
-private:
-
-    IntegerReaderImpl* impl_;
-
+//-----------------------------------------------------------------------------
+// 64 bits on every target, long is 32 on LLP64 (Windows).
+template <>
+class NumberReader<long long>
+{
+public:
+    NumberReader();
+    ~NumberReader();
+    int put(CharType ch);
+    size_t read(const CharType* str, size_t length);
+    long long value() const;
+    bool valid() const;
+    ReaderState save() const;
+    void restore(const ReaderState& state);
 };
 
 
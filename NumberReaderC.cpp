@@ -0,0 +1,155 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReaderC.h"
+#   include "FastNumberReader/NumberReader.h"
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "NumberReaderC.h"
+#   include "NumberReader.h"
+#   include "CharScan.h"
+#endif
+
+#include <new>
+
+struct fnr_reader
+{
+    fnr::DelimiterSet delimiters;
+};
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// The NumberReader is created on the calling thread, its state is that
+// thread's own (FNR_THREAD_SAFE), so the handle is only read here. A token
+// out of the range of T does not read, it is reported like a malformed one.
+template <typename T, typename Out>
+static int ParseTokens(const fnr_reader* reader, const char* buffer, size_t length,
+                       Out* out, size_t capacity, fnr_result* result)
+{
+    if (!reader || (!buffer && length) || (!out && capacity) || !result)
+        return FNR_ERROR_ARGUMENT;
+
+    result->count = 0;
+    result->consumed = 0;
+    result->error_offset = (size_t)-1;
+
+    const DelimiterSet& delimiters = reader->delimiters;
+    const CharType* end = buffer + length;
+    const CharType* p = SkipDelimiters(buffer, end, delimiters);
+    NumberReader<T> numberReader;
+    int status = FNR_OK;
+
+    while (p < end && result->count < capacity)
+    {
+        const size_t tokenLength = numberReader.read(p, end - p);
+        const CharType* tokenEnd = p + tokenLength;
+        if (!tokenLength ||
+            (tokenEnd < end && !IsSpaceChar(*tokenEnd) && !delimiters.contains(*tokenEnd)))
+        {
+            result->error_offset = p - buffer;
+            status = FNR_ERROR_SYNTAX;
+            break;
+        }
+
+        out[result->count++] = (Out)numberReader.value();
+        p = SkipDelimiters(tokenEnd, end, delimiters);
+    }
+
+    result->consumed = p - buffer;
+    return status;
+}
+
+} // end of fnr
+
+//-----------------------------------------------------------------------------
+fnr_reader* fnr_reader_create(const char* delimiters)
+{
+    return new (std::nothrow) fnr_reader { fnr::DelimiterSet(delimiters) };
+}
+
+//-----------------------------------------------------------------------------
+void fnr_reader_destroy(fnr_reader* reader)
+{
+    delete reader;
+}
+
+//-----------------------------------------------------------------------------
+int fnr_parse_double(const fnr_reader* reader, const char* buffer, size_t length,
+                     double* out, size_t capacity, fnr_result* result)
+{
+    return fnr::ParseTokens<double>(reader, buffer, length, out, capacity, result);
+}
+
+//-----------------------------------------------------------------------------
+int fnr_parse_float(const fnr_reader* reader, const char* buffer, size_t length,
+                    float* out, size_t capacity, fnr_result* result)
+{
+    return fnr::ParseTokens<float>(reader, buffer, length, out, capacity, result);
+}
+
+//-----------------------------------------------------------------------------
+int fnr_parse_int64(const fnr_reader* reader, const char* buffer, size_t length,
+                    int64_t* out, size_t capacity, fnr_result* result)
+{
+    return fnr::ParseTokens<long long>(reader, buffer, length, out, capacity, result);
+}
+
+//-----------------------------------------------------------------------------
+int fnr_parse_int32(const fnr_reader* reader, const char* buffer, size_t length,
+                    int32_t* out, size_t capacity, fnr_result* result)
+{
+    return fnr::ParseTokens<int>(reader, buffer, length, out, capacity, result);
+}
+
+//-----------------------------------------------------------------------------
+int fnr_parse_int16(const fnr_reader* reader, const char* buffer, size_t length,
+                    int16_t* out, size_t capacity, fnr_result* result)
+{
+    return fnr::ParseTokens<short>(reader, buffer, length, out, capacity, result);
+}
+
+//-----------------------------------------------------------------------------
+size_t fnr_count_tokens(const fnr_reader* reader, const char* buffer, size_t length)
+{
+    if (!reader || !buffer)
+        return 0;
+
+    const fnr::DelimiterSet& delimiters = reader->delimiters;
+    const char* end = buffer + length;
+    const char* p = fnr::SkipDelimiters(buffer, end, delimiters);
+    size_t count = 0;
+
+    while (p < end)
+    {
+        ++count;
+        while (p < end && !fnr::IsSpaceChar(*p) && !delimiters.contains(*p))
+            ++p;
+        p = fnr::SkipDelimiters(p, end, delimiters);
+    }
+    return count;
+}
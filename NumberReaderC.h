@@ -0,0 +1,90 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__NUMBERREADERC_H
+#define FAST_NUMBER_READER__NUMBERREADERC_H
+
+/*
+C interface for FFI consumers (Python, Rust, Go, ...). One call converts a
+whole buffer of tokens into a typed array, so the FFI boundary is crossed
+once per buffer instead of once per char.
+
+Tokens are split by the delimiters given to fnr_reader_create() and by
+whitespace. A handle only keeps its configuration, all parse state lives
+in the calling thread, so one handle can be used from many threads at once.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct fnr_reader fnr_reader;
+
+enum fnr_status
+{
+    FNR_OK = 0,
+    FNR_ERROR_SYNTAX = 1,   /* a token is not a number of the type, see error_offset */
+    FNR_ERROR_ARGUMENT = 2  /* null handle, buffer or output */
+};
+
+typedef struct fnr_result
+{
+    size_t count;           /* values written to the output array */
+    size_t consumed;        /* chars consumed, parsing may go on from here */
+    size_t error_offset;    /* offset of the malformed token, (size_t)-1 if none */
+} fnr_result;
+
+/* delimiters may be null or "" to split by whitespace only, at most 8 chars */
+fnr_reader* fnr_reader_create(const char* delimiters);
+void fnr_reader_destroy(fnr_reader* reader);
+
+/*
+Parse tokens of buffer until capacity values are written, the buffer ends
+or a malformed token is found. Stop on capacity leaves consumed at the
+next token, so a call with a fresh array continues the buffer. An integer
+token out of the range of the output type is a syntax error, its value
+is never wrapped.
+*/
+int fnr_parse_double(const fnr_reader* reader, const char* buffer, size_t length,
+                     double* out, size_t capacity, fnr_result* result);
+int fnr_parse_float(const fnr_reader* reader, const char* buffer, size_t length,
+                    float* out, size_t capacity, fnr_result* result);
+int fnr_parse_int64(const fnr_reader* reader, const char* buffer, size_t length,
+                    int64_t* out, size_t capacity, fnr_result* result);
+int fnr_parse_int32(const fnr_reader* reader, const char* buffer, size_t length,
+                    int32_t* out, size_t capacity, fnr_result* result);
+int fnr_parse_int16(const fnr_reader* reader, const char* buffer, size_t length,
+                    int16_t* out, size_t capacity, fnr_result* result);
+
+/* number of tokens in buffer, to size the output array */
+size_t fnr_count_tokens(const fnr_reader* reader, const char* buffer, size_t length);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // FAST_NUMBER_READER__NUMBERREADERC_H
@@ -0,0 +1,219 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReduce.h"
+#   include "FastNumberReader/StructuralIndex.h"
+#else
+#   include "NumberReduce.h"
+#   include "StructuralIndex.h"
+#endif
+
+#if (FNR_THREAD_SAFE==1)
+#   include <thread>
+#endif
+
+namespace fnr
+{
+
+// chars converted at a time, the values of a chunk stay in the cache
+static const size_t kReduceChunk = 1 << 15;
+
+#if (FNR_THREAD_SAFE==1)
+// below this many chars per thread a worker costs more than it saves
+static const size_t kMinCharsPerThread = 1 << 18;
+#endif
+
+//-----------------------------------------------------------------------------
+void NumberSummary::add(const double* values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        add(values[i]);
+}
+
+//-----------------------------------------------------------------------------
+void NumberSummary::merge(const NumberSummary& other)
+{
+    Accumulate(other.sum_);
+    compensation_ += other.compensation_;
+    if (other.min_ < min_)
+        min_ = other.min_;
+    if (other.max_ > max_)
+        max_ = other.max_;
+    count_ += other.count_;
+}
+
+//-----------------------------------------------------------------------------
+void NumberSummary::clear()
+{
+    sum_ = 0.0;
+    compensation_ = 0.0;
+    min_ = HUGE_VAL;
+    max_ = -HUGE_VAL;
+    count_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+NumberHistogram::NumberHistogram(double low, double high, unsigned int bins) :
+    low_(low),
+    high_(high),
+    scale_(high > low ? (bins ? bins : 1) / (high - low) : 0.0),
+    counts_(bins ? bins : 1),
+    below_(0),
+    above_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+void NumberHistogram::add(const double* values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        add(values[i]);
+}
+
+//-----------------------------------------------------------------------------
+void NumberHistogram::merge(const NumberHistogram& other)
+{
+    const size_t bins = counts_.size() < other.counts_.size() ? counts_.size() : other.counts_.size();
+    for (size_t i = 0; i < bins; ++i)
+        counts_[i] += other.counts_[i];
+    below_ += other.below_;
+    above_ += other.above_;
+}
+
+//-----------------------------------------------------------------------------
+void NumberHistogram::clear()
+{
+    counts_.assign(counts_.size(), 0);
+    below_ = 0;
+    above_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Converts [begin, end) chunk by chunk and adds the good values to reducer.
+template <typename T, typename Reducer>
+static size_t ReduceRange(const CharType* begin, const CharType* end,
+                          const DelimiterSet& delimiters, Reducer& reducer)
+{
+    StructuralIndex index(delimiters);
+    std::vector<T> values;
+    std::vector<ByteType> ok;
+    std::vector<double> batch;
+    size_t failed = 0;
+
+    while (begin < end)
+    {
+        // a chunk ends at a separator, so no token is split
+        const CharType* cut = ((size_t)(end - begin) > kReduceChunk)
+                              ? FindSeparator(begin + kReduceChunk, end, delimiters) : end;
+        const size_t count = index.build(begin, cut - begin);
+        if (count)
+        {
+            values.resize(count);
+            ok.resize(count);
+            batch.resize(count);
+            failed += ConvertTokens(begin, index, &values[0], &ok[0], 1);
+
+            size_t good = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                batch[good] = (double)values[i];
+                good += ok[i] != 0;
+            }
+            reducer.add(&batch[0], good);
+        }
+        begin = cut;
+    }
+    return failed;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T, typename Reducer>
+size_t ReduceNumbers(const CharType* text, size_t length, const DelimiterSet& delimiters,
+                     Reducer& reducer, unsigned int threads)
+{
+#if (FNR_THREAD_SAFE==1)
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (threads > length / kMinCharsPerThread)
+        threads = (unsigned int)(length / kMinCharsPerThread);
+
+    if (threads > 1)
+    {
+        const CharType* end = text + length;
+        std::vector<const CharType*> cuts(threads + 1, end);
+        cuts[0] = text;
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            const CharType* p = text + length / threads * t;
+            cuts[t] = FindSeparator(p < cuts[t - 1] ? cuts[t - 1] : p, end, delimiters);
+        }
+
+        // range 0 folds into reducer, the others into empty copies of it
+        std::vector<Reducer> partials(threads - 1, reducer);
+        std::vector<size_t> failed(threads);
+        std::vector<std::thread> workers;
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            partials[t - 1].clear();
+            workers.push_back(std::thread([t, &cuts, &delimiters, &partials, &failed]
+            {
+                failed[t] = ReduceRange<T>(cuts[t], cuts[t + 1], delimiters, partials[t - 1]);
+            }));
+        }
+
+        failed[0] = ReduceRange<T>(cuts[0], cuts[1], delimiters, reducer);
+
+        size_t total = failed[0];
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            workers[t - 1].join();
+            reducer.merge(partials[t - 1]);
+            total += failed[t];
+        }
+        return total;
+    }
+#else
+    (void)threads;
+#endif
+
+    return ReduceRange<T>(text, text + length, delimiters, reducer);
+}
+
+//-----------------------------------------------------------------------------
+template size_t ReduceNumbers<double>(const CharType*, size_t, const DelimiterSet&, NumberSummary&, unsigned int);
+template size_t ReduceNumbers<float>(const CharType*, size_t, const DelimiterSet&, NumberSummary&, unsigned int);
+template size_t ReduceNumbers<long double>(const CharType*, size_t, const DelimiterSet&, NumberSummary&, unsigned int);
+template size_t ReduceNumbers<long>(const CharType*, size_t, const DelimiterSet&, NumberSummary&, unsigned int);
+template size_t ReduceNumbers<int>(const CharType*, size_t, const DelimiterSet&, NumberSummary&, unsigned int);
+template size_t ReduceNumbers<short>(const CharType*, size_t, const DelimiterSet&, NumberSummary&, unsigned int);
+template size_t ReduceNumbers<double>(const CharType*, size_t, const DelimiterSet&, NumberHistogram&, unsigned int);
+template size_t ReduceNumbers<float>(const CharType*, size_t, const DelimiterSet&, NumberHistogram&, unsigned int);
+template size_t ReduceNumbers<long double>(const CharType*, size_t, const DelimiterSet&, NumberHistogram&, unsigned int);
+template size_t ReduceNumbers<long>(const CharType*, size_t, const DelimiterSet&, NumberHistogram&, unsigned int);
+template size_t ReduceNumbers<int>(const CharType*, size_t, const DelimiterSet&, NumberHistogram&, unsigned int);
+template size_t ReduceNumbers<short>(const CharType*, size_t, const DelimiterSet&, NumberHistogram&, unsigned int);
+
+} // end of fnr
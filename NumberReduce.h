@@ -0,0 +1,149 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__NUMBERREDUCE_H
+#define FAST_NUMBER_READER__NUMBERREDUCE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "CharScan.h"
+#endif
+
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Count, sum, min and max of a column. The sum is compensated (Kahan and
+// Babuska), so the rounding error does not grow with the count. While
+// empty, min() is +inf and max() is -inf.
+class NumberSummary
+{
+public:
+    NumberSummary() { clear(); }
+
+    void add(double value)
+    {
+        Accumulate(value);
+        if (value < min_)
+            min_ = value;
+        if (value > max_)
+            max_ = value;
+        ++count_;
+    }
+    void add(const double* values, size_t count);
+    void merge(const NumberSummary& other);
+    void clear();
+
+    size_t count() const { return count_; }
+    double sum() const { return sum_ + compensation_; }
+    double mean() const { return count_ ? sum() / (double)count_ : 0.0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+
+private:
+
+    // adds to sum_ and keeps the rounding error in compensation_
+    void Accumulate(double value)
+    {
+        const double sum = sum_ + value;
+        if (fabs(sum_) >= fabs(value))
+            compensation_ += (sum_ - sum) + value;
+        else
+            compensation_ += (value - sum) + sum_;
+        sum_ = sum;
+    }
+
+    double sum_;
+    double compensation_;
+    double min_;
+    double max_;
+    size_t count_;
+
+};
+
+//-----------------------------------------------------------------------------
+// Counts per bin of bins equal bins over [low, high), values outside go to
+// below() or above().
+class NumberHistogram
+{
+public:
+    NumberHistogram(double low, double high, unsigned int bins);
+
+    void add(double value)
+    {
+        if (!(value >= low_))
+            ++below_;
+        else if (!(value < high_))
+            ++above_;
+        else
+        {
+            size_t bin = (size_t)((value - low_) * scale_);
+            if (bin >= counts_.size())
+                bin = counts_.size() - 1;  // rounding just below high
+            ++counts_[bin];
+        }
+    }
+    void add(const double* values, size_t count);
+    // other should have the same range and bins
+    void merge(const NumberHistogram& other);
+    void clear();
+
+    unsigned int bins() const { return (unsigned int)counts_.size(); }
+    size_t count(unsigned int bin) const { return counts_[bin]; }
+    double binLow(unsigned int bin) const { return low_ + bin / scale_; }
+    size_t below() const { return below_; }
+    size_t above() const { return above_; }
+
+private:
+
+    double low_;
+    double high_;
+    double scale_;      // bins per unit
+    std::vector<size_t> counts_;
+    size_t below_;
+    size_t above_;
+
+};
+
+//-----------------------------------------------------------------------------
+// Parses the tokens of text as T and folds them into reducer without
+// storing the column: every thread converts its range a cache-sized chunk
+// at a time with the two-stage bulk reader and adds the chunk to its own
+// copy of the reducer, the copies are merged at the end. Tokens are split
+// by whitespace and delimiters, threads 0 takes one per core. Tokens that
+// are not exactly one number are left out, their count is returned.
+// Reducer is NumberSummary or NumberHistogram.
+template <typename T, typename Reducer>
+size_t ReduceNumbers(const CharType* text, size_t length, const DelimiterSet& delimiters,
+                     Reducer& reducer, unsigned int threads = 0);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__NUMBERREDUCE_H
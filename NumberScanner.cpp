@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberScanner.h"
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "NumberScanner.h"
+#   include "CharScan.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Integer types: a decimal number is one token as well, one the reader of
+// T would split at the point ("0.75" into 0 and 75). It is skipped whole:
+// whatever the double reader takes past the integer and its point. Returns
+// the token length, valid is false for a token that is not a T.
+template <typename T>
+static size_t ReadToken(NumberReader<T>& reader, const CharType* p, const CharType* end,
+                        T& value, bool& valid)
+{
+    NumberReader<double> decimal;
+    const size_t decimalLength = decimal.read(p, end - p);
+    const size_t length = reader.read(p, end - p);
+
+    valid = length && decimalLength <= length + 1;
+    if (!valid)
+        return decimalLength > length ? decimalLength : 0;
+
+    value = reader.value();
+    return length;
+}
+
+//-----------------------------------------------------------------------------
+static bool IsHexDigit(CharType ch)
+{
+    return (ch >= '0' && ch <= '9') || ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f');
+}
+
+//-----------------------------------------------------------------------------
+// Floating point types: a bare integer ("42") is a number too. A hex
+// integer is skipped whole, not read as 0 and digits.
+template <typename T>
+static size_t ReadFloatToken(NumberReader<T>& reader, const CharType* p, const CharType* end,
+                             T& value, bool& valid)
+{
+    const CharType* q = p;
+    if (q < end && (*q == '-' || *q == '+'))
+        ++q;
+    if (end - q > 2 && q[0] == '0' && (q[1] == 'x' || q[1] == 'X') && IsHexDigit(q[2]))
+    {
+        for (q += 2; q < end && IsHexDigit(*q); ++q)
+            ;
+        valid = false;
+        return q - p;
+    }
+
+    const size_t length = reader.readWithIntegers(p, end - p);
+    valid = length != 0;
+    if (valid)
+        value = reader.value();
+    return length;
+}
+
+static size_t ReadToken(NumberReader<double>& reader, const CharType* p, const CharType* end,
+                        double& value, bool& valid)
+{
+    return ReadFloatToken(reader, p, end, value, valid);
+}
+
+static size_t ReadToken(NumberReader<float>& reader, const CharType* p, const CharType* end,
+                        float& value, bool& valid)
+{
+    return ReadFloatToken(reader, p, end, value, valid);
+}
+
+static size_t ReadToken(NumberReader<long double>& reader, const CharType* p, const CharType* end,
+                        long double& value, bool& valid)
+{
+    return ReadFloatToken(reader, p, end, value, valid);
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+size_t NumberScanner<T>::scan(const CharType* text, size_t length,
+                              std::vector<ScannedNumber<T> >& numbers)
+{
+    const CharType* end = text + length;
+    const CharType* p = FindNumberStart(text, end);
+    size_t count = 0;
+
+    while (p < end)
+    {
+        T value;
+        bool valid = false;
+        const size_t tokenLength = ReadToken(reader_, p, end, value, valid);
+        if (tokenLength && valid)
+        {
+            ScannedNumber<T> number;
+            number.value = value;
+            number.offset = p - text;
+            number.length = tokenLength;
+            numbers.push_back(number);
+            ++count;
+            p += tokenLength;
+        }
+        else if (tokenLength)
+        {
+            p += tokenLength;
+        }
+        else if (*p >= '1' && *p <= '9')
+        {
+            // the readers end up in the same state from any later digit of
+            // this run, so they would fail there as well
+            do { ++p; } while (p < end && *p >= '0' && *p <= '9');
+        }
+        else
+        {
+            ++p;
+        }
+        p = FindNumberStart(p, end);
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+template class NumberScanner<double>;
+template class NumberScanner<float>;
+template class NumberScanner<long double>;
+template class NumberScanner<long>;
+template class NumberScanner<int>;
+template class NumberScanner<short>;
+
+} // end of fnr
@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__NUMBERSCANNER_H
+#define FAST_NUMBER_READER__NUMBERSCANNER_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReader.h"
+#else
+#   include "NumberReader.h"
+#endif
+
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+//
+template <typename T>
+struct ScannedNumber
+{
+    T value;
+    size_t offset;
+    size_t length;
+};
+
+//-----------------------------------------------------------------------------
+// Extracts every number embedded in free-form text (log lines, markup, etc).
+// Runs of chars that can not start a number are skipped by FindNumberStart()
+// without going through the reader state machine. Integers and decimal
+// numbers are split the same way for every T: the floating point scanners
+// take bare integers too and skip hex ones whole, the integer ones skip a
+// decimal number whole.
+template <typename T>
+class NumberScanner
+{
+public:
+    // Appends the numbers found in text to numbers, returns how many were added.
+    size_t scan(const CharType* text, size_t length,
+                std::vector<ScannedNumber<T> >& numbers);
+
+private:
+
+    NumberReader<T> reader_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__NUMBERSCANNER_H
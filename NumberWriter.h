@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__NUMBERWRITER_H
+#define FAST_NUMBER_READER__NUMBERWRITER_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stddef.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// The writing counterpart of NumberReader: formats a value so that the
+// reader of the same type reads it back bit for bit.
+//
+// float and double get the shortest digit string that rounds back to the
+// value (the Schubfach algorithm: three 128-bit multiplications by a cached
+// power of ten, no loops over digits), in fixed notation for decimal
+// exponents -6 .. 20 and in scientific notation otherwise. There is always
+// a point or an exponent, whole numbers end in ".0", as the floating point
+// readers want. long double takes 21 significant digits through the C
+// library unless it is the same type as double. Integers are written two
+// digits per step from a digit-pair table. Infinities and NaNs come out
+// as "inf", "-inf" and "nan", which the readers do not take.
+template <typename T>
+class NumberWriter
+{
+public:
+    enum { kMaxLength = 32 };
+
+    // Writes value to buffer, which must hold kMaxLength chars. No zero is
+    // appended; returns the chars written.
+    size_t write(T value, CharType* buffer) const;
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__NUMBERWRITER_H
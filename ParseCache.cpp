@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/ParseCache.h"
+#   include "FastNumberReader/FixedField.h"
+#else
+#   include "ParseCache.h"
+#   include "FixedField.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+static uint32_t LoadFourChars(const CharType* p)
+{
+    uint32_t chunk;
+    memcpy(&chunk, p, sizeof(chunk));
+    return chunk;
+}
+
+//-----------------------------------------------------------------------------
+// Packs 1..16 chars into two words without reading past the token: the
+// loads overlap for lengths that are not 4, 8 or 16, which is exact as the
+// length is a part of the key too.
+static void PackToken(const CharType* p, size_t length, uint64_t& key0, uint64_t& key1)
+{
+    if (length >= 8)
+    {
+        key0 = LoadEightChars(p);
+        key1 = LoadEightChars(p + length - 8);
+    }
+    else if (length >= 4)
+    {
+        key0 = LoadFourChars(p) | ((uint64_t)LoadFourChars(p + length - 4) << 32);
+        key1 = 0;
+    }
+    else
+    {
+        key0 = (ByteType)p[0] | ((uint64_t)(ByteType)p[length / 2] << 8) |
+               ((uint64_t)(ByteType)p[length - 1] << 16);
+        key1 = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+ParseCache<T>::ParseCache(unsigned int bits)
+{
+    if (bits < 1)
+        bits = 1;
+    else if (bits > 24)
+        bits = 24;
+
+    entries_.resize((size_t)1 << bits);
+    shift_ = 64 - bits;
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void ParseCache<T>::clear()
+{
+    for (size_t i = 0; i < entries_.size(); ++i)
+        entries_[i].length = 0;
+    hits_ = 0;
+    misses_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+bool ParseCache<T>::parse(const CharType* token, size_t length, T& value)
+{
+    if (!length || length > kMaxTokenLength)
+    {
+        ++misses_;
+        if (!length || reader_.read(token, length) != length)
+            return false;
+        value = reader_.value();
+        return true;
+    }
+
+    uint64_t key0, key1;
+    PackToken(token, length, key0, key1);
+
+    const uint64_t hash = (key0 * 0x9E3779B97F4A7C15ULL) ^ (key1 * 0xC2B2AE3D27D4EB4FULL) ^ length;
+    Entry& entry = entries_[(hash * 0xFF51AFD7ED558CCDULL) >> shift_];
+
+    if (entry.length == length && entry.key0 == key0 && entry.key1 == key1)
+    {
+        ++hits_;
+        if (entry.valid)
+            value = entry.value;
+        return entry.valid;
+    }
+
+    ++misses_;
+    entry.key0 = key0;
+    entry.key1 = key1;
+    entry.length = (ByteType)length;
+    entry.valid = reader_.read(token, length) == length;
+    entry.value = entry.valid ? reader_.value() : T(0);
+
+    if (entry.valid)
+        value = entry.value;
+    return entry.valid;
+}
+
+//-----------------------------------------------------------------------------
+template class ParseCache<double>;
+template class ParseCache<float>;
+template class ParseCache<long double>;
+template class ParseCache<long>;
+template class ParseCache<int>;
+template class ParseCache<short>;
+
+} // end of fnr
@@ -0,0 +1,87 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__PARSECACHE_H
+#define FAST_NUMBER_READER__PARSECACHE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReader.h"
+#else
+#   include "NumberReader.h"
+#endif
+
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Direct-mapped memo of recently parsed short tokens, for feeds that repeat
+// the same strings ("0", "1.00", status codes) over and over. The key is the
+// token itself, packed from at most two overlapping 8-char loads, so a hit
+// costs a hash and two compares instead of a run of the state machine.
+// Malformed tokens are remembered as well. The table has 2^bits entries and
+// never grows; a colliding token just replaces the old one.
+template <typename T>
+class ParseCache
+{
+public:
+    enum { kMaxTokenLength = 16 };
+
+    explicit ParseCache(unsigned int bits = 10);
+
+    // Same as NumberReader<T>::read(token, length) == length, and value()
+    // if so. Longer tokens than kMaxTokenLength always go to the reader.
+    bool parse(const CharType* token, size_t length, T& value);
+
+    void clear();
+
+    // misses count every run of the reader, uncacheable tokens included
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+private:
+
+    struct Entry
+    {
+        uint64_t key0;
+        uint64_t key1;
+        T value;
+        ByteType length;    // 0 for an empty entry
+        bool valid;
+    };
+
+    std::vector<Entry> entries_;
+    unsigned int shift_;
+    uint64_t hits_;
+    uint64_t misses_;
+
+    NumberReader<T> reader_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__PARSECACHE_H
@@ -0,0 +1,184 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/PullParser.h"
+#else
+#   include "PullParser.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+template <typename T>
+PullParser<T>::PullParser(const DelimiterSet& delimiters) : delimiters_(delimiters)
+{
+    reset();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void PullParser<T>::reset()
+{
+    chunk_ = pos_ = end_ = 0;
+    chunkOffset_ = 0;
+    tokenOffset_ = 0;
+    partial_ = ReaderState();
+    inToken_ = false;
+    skipping_ = false;
+    finished_ = false;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void PullParser<T>::feed(const CharType* chunk, size_t length)
+{
+    chunkOffset_ += end_ - chunk_;
+    chunk_ = pos_ = chunk;
+    end_ = chunk + length;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void PullParser<T>::finish()
+{
+    finished_ = true;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+ePullStatus PullParser<T>::next(T& value)
+{
+    if (inToken_ || skipping_)
+    {
+        ePullStatus status = ContinueToken(value);
+        if (kPullNeedInput != status || inToken_ || skipping_)
+            return status;
+    }
+
+    pos_ = SkipDelimiters(pos_, end_, delimiters_);
+    if (pos_ == end_)
+        return finished_ ? kPullEnd : kPullNeedInput;
+
+    const CharType* token = pos_;
+    tokenOffset_ = chunkOffset_ + (token - chunk_);
+
+    // whole tokens go through read(), only a cut one is fed char by char
+    const size_t length = reader_.read(token, end_ - token);
+    const CharType* tokenEnd = token + length;
+    if (length && tokenEnd < end_ && IsSeparator(*tokenEnd))
+    {
+        pos_ = tokenEnd;
+        value = reader_.value();
+        return kPullValue;
+    }
+
+    while (tokenEnd < end_ && !IsSeparator(*tokenEnd))
+        ++tokenEnd;
+
+    if (tokenEnd == end_ && !finished_)
+        return StartToken(token);
+
+    pos_ = tokenEnd;
+    if (!length || token + length != tokenEnd)
+        return kPullSyntaxError;
+
+    value = reader_.value();
+    return kPullValue;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+ePullStatus PullParser<T>::StartToken(const CharType* token)
+{
+    reader_.restore(ReaderState());
+    for (; token < end_; ++token)
+    {
+        if (!reader_.put(*token))
+        {
+            skipping_ = true;
+            pos_ = end_;
+            return kPullSyntaxError;
+        }
+    }
+
+    partial_ = reader_.save();
+    inToken_ = true;
+    pos_ = end_;
+    return kPullNeedInput;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+ePullStatus PullParser<T>::ContinueToken(T& value)
+{
+    const CharType* p = pos_;
+
+    if (skipping_)
+    {
+        while (p < end_ && !IsSeparator(*p))
+            ++p;
+        pos_ = p;
+        skipping_ = (p == end_ && !finished_);
+        return kPullNeedInput;
+    }
+
+    reader_.restore(partial_);
+    for (; p < end_ && !IsSeparator(*p); ++p)
+    {
+        if (!reader_.put(*p))
+        {
+            inToken_ = false;
+            skipping_ = true;
+            pos_ = p;
+            return kPullSyntaxError;
+        }
+    }
+
+    pos_ = p;
+    if (p == end_ && !finished_)
+    {
+        partial_ = reader_.save();
+        return kPullNeedInput;
+    }
+
+    inToken_ = false;
+    if (!reader_.valid())
+        return kPullSyntaxError;
+
+    value = reader_.value();
+    return kPullValue;
+}
+
+//-----------------------------------------------------------------------------
+template class PullParser<double>;
+template class PullParser<float>;
+template class PullParser<long double>;
+template class PullParser<long>;
+template class PullParser<int>;
+template class PullParser<short>;
+
+} // end of fnr
@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__PULLPARSER_H
+#define FAST_NUMBER_READER__PULLPARSER_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/NumberReader.h"
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "NumberReader.h"
+#   include "CharScan.h"
+#endif
+
+namespace fnr
+{
+
+enum ePullStatus
+{
+    kPullValue,         // value was set
+    kPullSyntaxError,   // a malformed token was skipped, see tokenOffset()
+    kPullNeedInput,     // the chunk is used up, feed() the next one or finish()
+    kPullEnd            // finish() was called and all input is parsed
+};
+
+//-----------------------------------------------------------------------------
+// Parses a stream given in chunks of any size, one value per next() call.
+// Tokens are split by whitespace and delimiters, empty fields are skipped.
+// A token cut by the end of a chunk is kept as a ReaderState, not as chars,
+// so the caller may reuse the chunk memory once next() asks for input,
+// other readers of the thread may run in between, and the parser may go on
+// on another thread (a coroutine resumed elsewhere, a pool worker).
+template <typename T>
+class PullParser
+{
+public:
+    explicit PullParser(const DelimiterSet& delimiters = DelimiterSet());
+
+    // chunk must stay valid until next() returns kPullNeedInput
+    void feed(const CharType* chunk, size_t length);
+    // No more chunks: a carried token is complete now.
+    void finish();
+    void reset();
+
+    ePullStatus next(T& value);
+
+    // Stream offset of the token of the last kPullValue or kPullSyntaxError.
+    uint64_t tokenOffset() const { return tokenOffset_; }
+
+private:
+
+    bool IsSeparator(CharType ch) const
+    {
+        return IsSpaceChar(ch) || delimiters_.contains(ch);
+    }
+
+    ePullStatus ContinueToken(T& value);
+    ePullStatus StartToken(const CharType* token);
+
+    DelimiterSet delimiters_;
+
+    const CharType* chunk_;
+    const CharType* pos_;
+    const CharType* end_;
+    uint64_t chunkOffset_;
+    uint64_t tokenOffset_;
+
+    ReaderState partial_;
+    bool inToken_;      // partial_ holds a token cut by the chunk end
+    bool skipping_;     // the rest of a malformed token is still to skip
+    bool finished_;
+
+    NumberReader<T> reader_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__PULLPARSER_H
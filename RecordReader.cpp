@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/RecordReader.h"
+#   include "FastNumberReader/FloatBatch.h"
+#   include "FastNumberReader/NumberReader.h"
+#else
+#   include "RecordReader.h"
+#   include "FloatBatch.h"
+#   include "NumberReader.h"
+#endif
+
+#include <string.h>
+#if (FNR_THREAD_SAFE==1)
+#   include <thread>
+#endif
+
+namespace fnr
+{
+
+#if (FNR_THREAD_SAFE==1)
+// below this many chars per thread a worker costs more than it saves
+static const size_t kMinCharsPerThread = 1 << 16;
+#endif
+
+//-----------------------------------------------------------------------------
+static bool IsBlank(CharType ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+//-----------------------------------------------------------------------------
+static const CharType* SkipBlanks(const CharType* p, const CharType* end)
+{
+    while (p < end && IsBlank(*p))
+        ++p;
+    return p;
+}
+
+//-----------------------------------------------------------------------------
+RecordReader::RecordReader(unsigned int arity, const char* prefix, eRecordLayout layout) :
+    arity_(arity < 1 ? 1 : (arity > kMaxArity ? (unsigned int)kMaxArity : arity)),
+    prefix_(prefix ? prefix : ""),
+    layout_(layout),
+    arrays_(layout == kRecordFields ? arity_ : 1),
+    recordCount_(0),
+    skippedLines_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+void RecordReader::clear()
+{
+    for (size_t i = 0; i < arrays_.size(); ++i)
+        arrays_[i].clear();
+    recordCount_ = 0;
+    skippedLines_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+void RecordReader::read(const CharType* text, size_t length, unsigned int threads)
+{
+#if (FNR_THREAD_SAFE==1)
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (threads > length / kMinCharsPerThread)
+        threads = (unsigned int)(length / kMinCharsPerThread);
+
+    if (threads > 1)
+    {
+        // ranges end after a line end, so no record is split
+        const CharType* end = text + length;
+        std::vector<const CharType*> cuts(threads + 1, end);
+        cuts[0] = text;
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            const CharType* p = text + length / threads * t;
+            if (p < cuts[t - 1])
+                p = cuts[t - 1];
+            const CharType* lineEnd = (const CharType*)memchr(p, '\n', end - p);
+            cuts[t] = lineEnd ? lineEnd + 1 : end;
+        }
+
+        // range 0 appends in place, the others to their own arrays
+        std::vector<std::vector<std::vector<float> > > arrays(threads);
+        std::vector<Output> outputs(threads);
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+            arrays[t].resize(t ? arrays_.size() : 0);
+            Output out = { t ? &arrays[t][0] : &arrays_[0], 0, 0 };
+            outputs[t] = out;
+        }
+
+        std::vector<std::thread> workers;
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            workers.push_back(std::thread([this, t, &cuts, &outputs]
+            {
+                ReadRange(cuts[t], cuts[t + 1], outputs[t]);
+            }));
+        }
+
+        ReadRange(cuts[0], cuts[1], outputs[0]);
+
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+            if (t)
+            {
+                workers[t - 1].join();
+                for (size_t i = 0; i < arrays_.size(); ++i)
+                    arrays_[i].insert(arrays_[i].end(), arrays[t][i].begin(), arrays[t][i].end());
+            }
+            recordCount_ += outputs[t].records;
+            skippedLines_ += outputs[t].skipped;
+        }
+        return;
+    }
+#else
+    (void)threads;
+#endif
+
+    Output out = { &arrays_[0], 0, 0 };
+    ReadRange(text, text + length, out);
+    recordCount_ += out.records;
+    skippedLines_ += out.skipped;
+}
+
+//-----------------------------------------------------------------------------
+void RecordReader::ReadRange(const CharType* begin, const CharType* end, Output& out) const
+{
+    float values[kMaxArity];
+    while (begin < end)
+    {
+        const CharType* lineEnd = (const CharType*)memchr(begin, '\n', end - begin);
+        if (!lineEnd)
+            lineEnd = end;
+
+        const int result = ReadRecord(begin, lineEnd, values);
+        if (result > 0)
+        {
+            if (layout_ == kRecordFields)
+            {
+                for (unsigned int i = 0; i < arity_; ++i)
+                    out.arrays[i].push_back(values[i]);
+            }
+            else
+            {
+                out.arrays[0].insert(out.arrays[0].end(), values, values + arity_);
+            }
+            ++out.records;
+        }
+        else if (result < 0)
+        {
+            ++out.skipped;
+        }
+
+        begin = lineEnd + (lineEnd < end);
+    }
+}
+
+//-----------------------------------------------------------------------------
+int RecordReader::ReadRecord(const CharType* p, const CharType* end, float* values) const
+{
+    p = SkipBlanks(p, end);
+    if (p == end || *p == '#')
+        return 0;
+
+    if (!prefix_.empty())
+    {
+        const size_t prefixLength = prefix_.size();
+        if ((size_t)(end - p) < prefixLength ||
+            memcmp(p, prefix_.data(), prefixLength) != 0 ||
+            (p + prefixLength < end && !IsBlank(p[prefixLength])))
+            return 0;
+        p += prefixLength;
+    }
+
+    for (unsigned int i = 0; i < arity_; ++i)
+    {
+        p = SkipBlanks(p, end);
+        if (p == end)
+            return -1;
+
+        size_t length = ReadSimpleFloat(p, end, values[i]);
+        if (!length || (p + length < end && !IsBlank(p[length])))
+        {
+            NumberReader<float> reader;
+            length = reader.read(p, end - p);
+            if (!length || (p + length < end && !IsBlank(p[length])))
+                return -1;
+            values[i] = reader.value();
+        }
+        p += length;
+    }
+    return 1;
+}
+
+} // end of fnr
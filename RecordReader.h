@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__RECORDREADER_H
+#define FAST_NUMBER_READER__RECORDREADER_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace fnr
+{
+
+enum eRecordLayout
+{
+    kRecordFields,      // one array per field: x x x ..., y y y ..., z z z ...
+    kRecordInterleaved  // one array of whole records: x y z x y z ...
+};
+
+//-----------------------------------------------------------------------------
+// Reads lines of arity float fields, as in OBJ vertices ("v x y z"), PLY
+// ASCII bodies or XYZ point clouds. Fields are split by blanks and go
+// through the fast loop of ReadFloats, NumberReader<float> takes the rest.
+// With a prefix only lines whose first field is the prefix are records
+// ("v" takes "v" lines but not "vn" or "f" lines), other lines are passed
+// over. Blank lines and lines starting with '#' are always passed over.
+// Fields past the arity are ignored (the w of OBJ, PLY normals and
+// colors), a line with fewer or malformed fields is skipped and counted.
+class RecordReader
+{
+public:
+    enum { kMaxArity = 16 };
+
+    explicit RecordReader(unsigned int arity, const char* prefix = 0,
+                          eRecordLayout layout = kRecordFields);
+
+    // Appends the records of text, the last line may have no line end.
+    // The lines are split into ranges for up to threads threads (0 takes
+    // one per core), the records keep their order.
+    void read(const CharType* text, size_t length, unsigned int threads = 1);
+    void clear();
+
+    unsigned int arity() const { return arity_; }
+    size_t recordCount() const { return recordCount_; }
+    // Record lines that did not hold arity numbers.
+    size_t skippedLines() const { return skippedLines_; }
+
+    // Field i of every record, for kRecordFields.
+    const std::vector<float>& field(unsigned int i) const { return arrays_[i]; }
+    // All records one after the other, for kRecordInterleaved.
+    const std::vector<float>& values() const { return arrays_[0]; }
+
+private:
+
+    struct Output
+    {
+        std::vector<float>* arrays;
+        size_t records;
+        size_t skipped;
+    };
+
+    void ReadRange(const CharType* begin, const CharType* end, Output& out) const;
+    // 1 for a record, 0 for a line passed over, -1 for a bad record line
+    int ReadRecord(const CharType* p, const CharType* end, float* values) const;
+
+    unsigned int arity_;
+    std::string prefix_;
+    eRecordLayout layout_;
+    std::vector<std::vector<float> > arrays_;
+    size_t recordCount_;
+    size_t skippedLines_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__RECORDREADER_H
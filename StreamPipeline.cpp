@@ -0,0 +1,390 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/StreamPipeline.h"
+#else
+#   include "StreamPipeline.h"
+#endif
+
+#include <string.h>
+#if (FNR_THREAD_SAFE==1)
+#   include <atomic>
+#   include <condition_variable>
+#   include <memory>
+#   include <mutex>
+#   include <thread>
+#endif
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <poll.h>
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+template <typename T>
+struct StreamPipeline<T>::Job
+{
+    std::vector<CharType> text;
+    size_t length;
+    std::vector<T> values;
+    size_t failed;
+};
+
+#if (FNR_THREAD_SAFE==1)
+//-----------------------------------------------------------------------------
+// Lock-free ring of job pointers for one producer and one consumer thread.
+// Each index is written by one side only, the padding keeps the two on
+// separate cache lines. A side that finds the ring empty (or full) spins
+// a little, then sleeps on the condition until the other side moves its
+// index; the mutex is only taken while someone sleeps.
+template <typename T>
+class StreamPipeline<T>::Ring
+{
+public:
+    explicit Ring(size_t capacity) : mask_(0), head_(0), tail_(0), sleepers_(0)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    bool push(Job* job)
+    {
+        if (!TryPush(job))
+            return false;
+        Wake();
+        return true;
+    }
+
+    bool pop(Job*& job)
+    {
+        if (!TryPop(job))
+            return false;
+        Wake();
+        return true;
+    }
+
+    // Blocking forms, for the full and the empty ring.
+    void put(Job* job)
+    {
+        for (unsigned int spins = 0; !push(job); ++spins)
+        {
+            if (spins >= kSpins)
+            {
+                Park([&]() { return TryPush(job); });
+                return;
+            }
+            if (spins >= kSpins / 4)
+                std::this_thread::yield();
+        }
+    }
+
+    Job* take()
+    {
+        Job* job = 0;
+        for (unsigned int spins = 0; !pop(job); ++spins)
+        {
+            if (spins >= kSpins)
+            {
+                Park([&]() { return TryPop(job); });
+                break;
+            }
+            if (spins >= kSpins / 4)
+                std::this_thread::yield();
+        }
+        return job;
+    }
+
+private:
+
+    enum { kSpins = 64 };
+
+    bool TryPush(Job* job)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_)
+            return false;
+        slots_[tail & mask_] = job;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(Job*& job)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+        job = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Sleeps until attempt succeeds. The sleeper counts itself before it
+    // tries again and the other side checks the count after it moved its
+    // index, each behind a full fence, so one of the two sees the other.
+    template <typename Attempt>
+    void Park(Attempt attempt)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleepers_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!attempt())
+                changed_.wait(lock);
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        Wake();
+    }
+
+    void Wake()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            changed_.notify_all();
+        }
+    }
+
+    std::vector<Job*> slots_;
+    size_t mask_;
+    char pad0_[64];
+    std::atomic<size_t> head_;      // written by the consumer
+    char pad1_[64];
+    std::atomic<size_t> tail_;      // written by the producer
+    char pad2_[64];
+    std::atomic<unsigned int> sleepers_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+};
+#endif
+
+//-----------------------------------------------------------------------------
+// Sleeps until a non-blocking source may have data again, or for a
+// millisecond if there is no descriptor to wait on.
+static void WaitForInput(const ByteSource& source)
+{
+#ifndef _WIN32
+    pollfd wait;
+    wait.fd = source.descriptor();
+    wait.events = POLLIN;
+    wait.revents = 0;
+    if (wait.fd >= 0)
+        poll(&wait, 1, -1);
+    else
+        poll(0, 0, 1);
+#else
+    (void)source;
+    Sleep(1);   // pipes cannot be waited on
+#endif
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+StreamPipeline<T>::StreamPipeline(unsigned int threads, size_t bufferSize,
+                                  unsigned int buffersPerThread,
+                                  const DelimiterSet& delimiters)
+  : threads_(threads),
+    bufferSize_(bufferSize ? bufferSize : 1),
+    buffersPerThread_(buffersPerThread ? buffersPerThread : 1),
+    delimiters_(delimiters),
+    failed_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+typename StreamPipeline<T>::eFill StreamPipeline<T>::Fill(ByteSource& source, Job& job)
+{
+    job.text.resize(bufferSize_);
+    CharType* buffer = &job.text[0];
+    size_t length = carry_.size();
+    if (length)
+        memcpy(buffer, carry_.data(), length);
+    carry_.clear();
+
+    eFill state = kFillMore;
+    while (length < bufferSize_)
+    {
+        const long count = source.read(buffer + length, bufferSize_ - length);
+        if (count > 0)
+        {
+            length += (size_t)count;
+            continue;
+        }
+        if (count == ByteSource::kWouldBlock)
+        {
+            WaitForInput(source);
+            continue;
+        }
+        state = (count == ByteSource::kEnd) ? kFillLast : kFillError;
+        break;
+    }
+
+    job.length = length;
+    if (state == kFillMore)
+    {
+        size_t cut = length;
+        while (cut > 0 && !IsSeparator(buffer[cut - 1]))
+            --cut;
+        // without any separator the token fills the buffer and is split
+        if (cut > 0)
+        {
+            carry_.assign(buffer + cut, buffer + length);
+            job.length = cut;
+        }
+    }
+    return state;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void StreamPipeline<T>::Parse(Job& job, StructuralIndex& index) const
+{
+    const size_t count = index.build(job.length ? &job.text[0] : 0, job.length);
+    job.values.resize(count);
+    job.failed = count ? ConvertTokens(&job.text[0], index, &job.values[0], 0, 1) : 0;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+bool StreamPipeline<T>::RunSerial(ByteSource& source, ValueSink<T>& sink)
+{
+    Job job;
+    StructuralIndex index(delimiters_);
+    for (;;)
+    {
+        const eFill state = Fill(source, job);
+        Parse(job, index);
+        if (!job.values.empty())
+            sink.consume(&job.values[0], job.values.size());
+        failed_ += job.failed;
+        if (state != kFillMore)
+            return state == kFillLast;
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+bool StreamPipeline<T>::run(ByteSource& source, ValueSink<T>& sink)
+{
+    failed_ = 0;
+    carry_.clear();
+
+#if (FNR_THREAD_SAFE==1)
+    unsigned int threads = threads_;
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    // every ring can hold all jobs and the end marker, so only the free
+    // list ever makes a thread wait for room
+    const size_t jobCount = (size_t)threads * buffersPerThread_;
+    std::vector<Job> jobs(jobCount);
+    Ring freeJobs(jobCount);
+    std::vector<std::unique_ptr<Ring> > inputs, outputs;
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        inputs.push_back(std::unique_ptr<Ring>(new Ring(jobCount + 1)));
+        outputs.push_back(std::unique_ptr<Ring>(new Ring(jobCount + 1)));
+    }
+    for (size_t i = 0; i < jobCount; ++i)
+        freeJobs.push(&jobs[i]);
+
+    // buffer k goes to parser k % threads, a null job marks the end
+    bool readOk = true;
+    std::thread reader([&]()
+    {
+        unsigned int next = 0;
+        for (;;)
+        {
+            Job* job = freeJobs.take();
+            const eFill state = Fill(source, *job);
+            inputs[next]->put(job);
+            next = (next + 1) % threads;
+            if (state != kFillMore)
+            {
+                readOk = (state == kFillLast);
+                break;
+            }
+        }
+        for (unsigned int t = 0; t < threads; ++t)
+            inputs[(next + t) % threads]->put(0);
+    });
+
+    std::vector<std::thread> parsers;
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        parsers.push_back(std::thread([&, t]()
+        {
+            StructuralIndex index(delimiters_);
+            for (;;)
+            {
+                Job* job = inputs[t]->take();
+                if (job)
+                    Parse(*job, index);
+                outputs[t]->put(job);
+                if (!job)
+                    break;
+            }
+        }));
+    }
+
+    for (unsigned int next = 0; ; next = (next + 1) % threads)
+    {
+        Job* job = outputs[next]->take();
+        if (!job)
+            break;
+        if (!job->values.empty())
+            sink.consume(&job->values[0], job->values.size());
+        failed_ += job->failed;
+        freeJobs.put(job);
+    }
+
+    reader.join();
+    for (unsigned int t = 0; t < threads; ++t)
+        parsers[t].join();
+    return readOk;
+#else
+    return RunSerial(source, sink);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+template class StreamPipeline<double>;
+template class StreamPipeline<float>;
+template class StreamPipeline<long double>;
+template class StreamPipeline<long>;
+template class StreamPipeline<int>;
+template class StreamPipeline<short>;
+
+} // end of fnr
@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__STREAMPIPELINE_H
+#define FAST_NUMBER_READER__STREAMPIPELINE_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/ByteSource.h"
+#   include "FastNumberReader/StructuralIndex.h"
+#else
+#   include "ByteSource.h"
+#   include "StructuralIndex.h"
+#endif
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Receives the values of a stream in stream order.
+template <typename T>
+class ValueSink
+{
+public:
+    virtual ~ValueSink() {}
+
+    virtual void consume(const T* values, size_t count) = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Parses an unbounded stream on several cores with fixed memory. An I/O
+// thread fills buffers of bufferSize chars from the source, cut after the
+// last separator, the cut token goes to the front of the next buffer. The
+// buffers are dealt round robin to the parser threads over lock-free
+// single-producer/single-consumer rings, and the calling thread collects
+// them in the same order and passes the values to the sink. There are
+// buffersPerThread buffers per parser thread and no more, so a slow sink
+// stalls the parsers and they stall the reads.
+// A token longer than a buffer is split in two. Without FNR_THREAD_SAFE
+// everything runs on the calling thread.
+template <typename T>
+class StreamPipeline
+{
+public:
+    explicit StreamPipeline(unsigned int threads = 0, size_t bufferSize = 1 << 20,
+                            unsigned int buffersPerThread = 2,
+                            const DelimiterSet& delimiters = DelimiterSet());
+
+    // Parses source up to its end. Returns false on a read error, the
+    // values before it have been passed to the sink then.
+    bool run(ByteSource& source, ValueSink<T>& sink);
+
+    // Tokens of the last run that were not exactly one number, they are
+    // passed on as 0.
+    size_t failed() const { return failed_; }
+
+private:
+
+    struct Job;
+    class Ring;
+
+    enum eFill { kFillMore, kFillLast, kFillError };
+
+    bool IsSeparator(CharType ch) const
+    {
+        return IsSpaceChar(ch) || delimiters_.contains(ch);
+    }
+
+    eFill Fill(ByteSource& source, Job& job);
+    void Parse(Job& job, StructuralIndex& index) const;
+    bool RunSerial(ByteSource& source, ValueSink<T>& sink);
+
+    unsigned int threads_;
+    size_t bufferSize_;
+    unsigned int buffersPerThread_;
+    DelimiterSet delimiters_;
+    std::string carry_;     // the cut token, between two Fill() calls
+    size_t failed_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__STREAMPIPELINE_H
@@ -0,0 +1,336 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/StructuralIndex.h"
+#   include "FastNumberReader/IntegerBatch.h"
+#   include "FastNumberReader/NumberReader.h"
+#else
+#   include "StructuralIndex.h"
+#   include "IntegerBatch.h"
+#   include "NumberReader.h"
+#endif
+
+#include <string.h>
+#if (FNR_THREAD_SAFE==1)
+#   include <thread>
+#endif
+#if (FNR_SSE2==1)
+#   include <emmintrin.h>
+#endif
+
+namespace fnr
+{
+
+#if (FNR_THREAD_SAFE==1)
+// below this many tokens per thread a worker costs more than it saves
+static const size_t kMinTokensPerThread = 1 << 14;
+#endif
+
+#if (FNR_SSE2==1)
+//-----------------------------------------------------------------------------
+static uint64_t MaskBits(__m128i m0, __m128i m1, __m128i m2, __m128i m3)
+{
+    return (uint64_t)(unsigned int)_mm_movemask_epi8(m0) |
+           ((uint64_t)(unsigned int)_mm_movemask_epi8(m1) << 16) |
+           ((uint64_t)(unsigned int)_mm_movemask_epi8(m2) << 32) |
+           ((uint64_t)(unsigned int)_mm_movemask_epi8(m3) << 48);
+}
+
+//-----------------------------------------------------------------------------
+// '\t' .. '\r' without '\f' as one unsigned range test, or ' '
+static __m128i SpaceBytes(__m128i chunk)
+{
+    const __m128i d = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+    const __m128i range = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(4)), d);
+    const __m128i formFeed = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\f'));
+    return _mm_or_si128(_mm_andnot_si128(formFeed, range),
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Bit i is set if block[i] is whitespace or a delimiter.
+static uint64_t SeparatorBits(const CharType* block, const DelimiterSet& delimiters)
+{
+#if (FNR_SSE2==1)
+    const __m128i c0 = _mm_loadu_si128((const __m128i*)block);
+    const __m128i c1 = _mm_loadu_si128((const __m128i*)(block + 16));
+    const __m128i c2 = _mm_loadu_si128((const __m128i*)(block + 32));
+    const __m128i c3 = _mm_loadu_si128((const __m128i*)(block + 48));
+
+    __m128i m0 = SpaceBytes(c0);
+    __m128i m1 = SpaceBytes(c1);
+    __m128i m2 = SpaceBytes(c2);
+    __m128i m3 = SpaceBytes(c3);
+
+    for (int i = 0; i < delimiters.count(); ++i)
+    {
+        const __m128i set = _mm_set1_epi8(delimiters.at(i));
+        m0 = _mm_or_si128(m0, _mm_cmpeq_epi8(c0, set));
+        m1 = _mm_or_si128(m1, _mm_cmpeq_epi8(c1, set));
+        m2 = _mm_or_si128(m2, _mm_cmpeq_epi8(c2, set));
+        m3 = _mm_or_si128(m3, _mm_cmpeq_epi8(c3, set));
+    }
+
+    return MaskBits(m0, m1, m2, m3);
+#else
+    uint64_t bits = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        if (IsSpaceChar(block[i]) || delimiters.contains(block[i]))
+            bits |= (uint64_t)1 << i;
+    }
+    return bits;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+StructuralIndex::StructuralIndex(const DelimiterSet& delimiters) :
+    delimiters_(delimiters), count_(0), length_(0)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+size_t StructuralIndex::build(const CharType* text, size_t length)
+{
+    const size_t blocks = (length + 63) / 64;
+
+    // one all-separator word after the last block ends every token
+    separators_.resize(blocks + 1);
+    separators_[blocks] = ~(uint64_t)0;
+    before_.resize(blocks);
+    sampleBlocks_.clear();
+    length_ = length;
+    count_ = 0;
+
+    uint64_t previous = 1;
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const size_t base = block * 64;
+        uint64_t bits;
+        if (length - base >= 64)
+        {
+            bits = SeparatorBits(text + base, delimiters_);
+        }
+        else
+        {
+            CharType padded[64];
+            memset(padded, ' ', sizeof(padded));
+            memcpy(padded, text + base, length - base);
+            bits = SeparatorBits(padded, delimiters_);
+        }
+
+        separators_[block] = bits;
+        before_[block] = count_;
+        count_ += BitCount64(~bits & ((bits << 1) | previous));
+        previous = bits >> 63;
+
+        while (sampleBlocks_.size() * kSampleStep < count_)
+            sampleBlocks_.push_back(block);
+    }
+
+    return count_;
+}
+
+//-----------------------------------------------------------------------------
+size_t StructuralIndex::tokenBegin(size_t i) const
+{
+    // last block whose first token is at or before i, the samples narrow
+    // the search to the blocks of kSampleStep tokens
+    const size_t sample = i / kSampleStep;
+    size_t low = sampleBlocks_[sample];
+    size_t high = (sample + 1 < sampleBlocks_.size()) ? sampleBlocks_[sample + 1] + 1 : before_.size();
+    while (high - low > 1)
+    {
+        const size_t middle = low + (high - low) / 2;
+        if (before_[middle] <= i)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    uint64_t begins = tokenBegins(low);
+    for (size_t k = before_[low]; k < i; ++k)
+        begins &= begins - 1;
+    return low * 64 + LowestBitIndex64(begins);
+}
+
+//-----------------------------------------------------------------------------
+size_t StructuralIndex::tokenEnd(size_t begin) const
+{
+    size_t block = begin / 64;
+    uint64_t bits = separators_[block] & (~(uint64_t)0 << (begin % 64));
+    while (!bits)
+        bits = separators_[++block];
+
+    const size_t end = block * 64 + LowestBitIndex64(bits);
+    return (end < length_) ? end : length_;
+}
+
+//-----------------------------------------------------------------------------
+// The integer types take short plain tokens through the lane kernel.
+template <typename T>
+static unsigned int ConvertLanes(const CharType*, size_t, const size_t*, const size_t*,
+                                 unsigned int, T*)
+{
+    return 0;
+}
+
+static unsigned int ConvertLanes(const CharType* text, size_t length, const size_t* begins,
+                                 const size_t* ends, unsigned int count, long* out)
+{
+    return ConvertIntegerLanes(text, length, begins, ends, count, out);
+}
+
+static unsigned int ConvertLanes(const CharType* text, size_t length, const size_t* begins,
+                                 const size_t* ends, unsigned int count, int* out)
+{
+    return ConvertIntegerLanes(text, length, begins, ends, count, out);
+}
+
+static unsigned int ConvertLanes(const CharType* text, size_t length, const size_t* begins,
+                                 const size_t* ends, unsigned int count, short* out)
+{
+    return ConvertIntegerLanes(text, length, begins, ends, count, out);
+}
+
+//-----------------------------------------------------------------------------
+// Converts count tokens with consecutive indices, returns the failed ones.
+template <typename T>
+static size_t ConvertBatch(NumberReader<T>& reader, const CharType* text, size_t length,
+                           const size_t* begins, const size_t* ends, unsigned int count,
+                           T* out, ByteType* ok)
+{
+    const unsigned int converted = ConvertLanes(text, length, begins, ends, count, out);
+    size_t failed = 0;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        bool good = true;
+        if (!(converted & (1u << i)))
+        {
+            const size_t tokenLength = ends[i] - begins[i];
+            good = reader.read(text + begins[i], tokenLength) == tokenLength;
+            out[i] = good ? reader.value() : T(0);
+        }
+        if (ok)
+            ok[i] = good;
+        failed += !good;
+    }
+
+    return failed;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+static size_t ConvertBlocks(const CharType* text, const StructuralIndex& index,
+                            size_t first, size_t last, T* out, ByteType* ok)
+{
+    NumberReader<T> reader;
+    size_t begins[kIntegerLanes];
+    size_t ends[kIntegerLanes];
+    unsigned int n = 0;
+    size_t failed = 0;
+    size_t i = (first < last) ? index.tokensBefore(first) : 0;
+
+    for (size_t block = first; block < last; ++block)
+    {
+        for (uint64_t bits = index.tokenBegins(block); bits; bits &= bits - 1)
+        {
+            begins[n] = block * 64 + LowestBitIndex64(bits);
+            ends[n] = index.tokenEnd(begins[n]);
+            if (++n < kIntegerLanes)
+                continue;
+
+            failed += ConvertBatch(reader, text, index.length(), begins, ends, n,
+                                   out + i, ok ? ok + i : 0);
+            i += n;
+            n = 0;
+        }
+    }
+
+    failed += ConvertBatch(reader, text, index.length(), begins, ends, n,
+                           out + i, ok ? ok + i : 0);
+    return failed;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+size_t ConvertTokens(const CharType* text, const StructuralIndex& index,
+                     T* out, ByteType* ok, unsigned int threads)
+{
+    const size_t blocks = index.blockCount();
+
+#if (FNR_THREAD_SAFE==1)
+    // every thread has its own reader state, so ranges convert independently
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (threads > index.size() / kMinTokensPerThread)
+        threads = (unsigned int)(index.size() / kMinTokensPerThread);
+
+    if (threads > 1)
+    {
+        std::vector<std::thread> workers;
+        std::vector<size_t> failed(threads);
+        const size_t step = (blocks + threads - 1) / threads;
+
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            const size_t first = (t * step < blocks) ? t * step : blocks;
+            const size_t last = (first + step < blocks) ? first + step : blocks;
+            workers.push_back(std::thread([=, &index, &failed]
+            {
+                failed[t] = ConvertBlocks(text, index, first, last, out, ok);
+            }));
+        }
+
+        failed[0] = ConvertBlocks(text, index, 0, step, out, ok);
+
+        size_t total = failed[0];
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            workers[t - 1].join();
+            total += failed[t];
+        }
+        return total;
+    }
+#else
+    (void)threads;
+#endif
+
+    return ConvertBlocks(text, index, 0, blocks, out, ok);
+}
+
+//-----------------------------------------------------------------------------
+template size_t ConvertTokens(const CharType*, const StructuralIndex&, double*, ByteType*, unsigned int);
+template size_t ConvertTokens(const CharType*, const StructuralIndex&, float*, ByteType*, unsigned int);
+template size_t ConvertTokens(const CharType*, const StructuralIndex&, long double*, ByteType*, unsigned int);
+template size_t ConvertTokens(const CharType*, const StructuralIndex&, long*, ByteType*, unsigned int);
+template size_t ConvertTokens(const CharType*, const StructuralIndex&, int*, ByteType*, unsigned int);
+template size_t ConvertTokens(const CharType*, const StructuralIndex&, short*, ByteType*, unsigned int);
+
+} // end of fnr
@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__STRUCTURALINDEX_H
+#define FAST_NUMBER_READER__STRUCTURALINDEX_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "CharScan.h"
+#endif
+
+#include <stddef.h>
+#include <vector>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Stage 1 of the two-stage bulk read: finds every token of a buffer without
+// parsing it. Each 64-char block becomes a separator bitmap (whitespace or
+// one of the delimiters), and token starts are the edges of its complement.
+// Only the bitmap and a running token count per block are stored, a quarter
+// of a byte per char, so the pass runs near memory speed; turning bits into
+// offsets is left to stage 2, where it is spread over the threads.
+class StructuralIndex
+{
+public:
+    enum { kSampleStep = 256 };
+
+    explicit StructuralIndex(const DelimiterSet& delimiters = DelimiterSet());
+
+    // Indexes text, returns the number of tokens.
+    size_t build(const CharType* text, size_t length);
+
+    size_t size() const { return count_; }
+    size_t length() const { return length_; }
+    size_t blockCount() const { return before_.size(); }
+
+    // Bit i is set if char 64 * block + i is a separator, chars past the
+    // end count as separators.
+    uint64_t separators(size_t block) const { return separators_[block]; }
+    // Bit i is set if a token starts at char 64 * block + i.
+    uint64_t tokenBegins(size_t block) const
+    {
+        const uint64_t previous = block ? separators_[block - 1] >> 63 : 1;
+        return ~separators_[block] & ((separators_[block] << 1) | previous);
+    }
+    // Tokens that start before the block, the index of its first token.
+    size_t tokensBefore(size_t block) const { return before_[block]; }
+    // Offset of token i, found from the block counts without a scan.
+    size_t tokenBegin(size_t i) const;
+    // Offset of the separator that ends the token starting at begin.
+    size_t tokenEnd(size_t begin) const;
+
+private:
+
+    DelimiterSet delimiters_;
+    std::vector<uint64_t> separators_;
+    std::vector<size_t> before_;
+    std::vector<size_t> sampleBlocks_;  // block of every kSampleStep-th token
+    size_t count_;
+    size_t length_;
+
+};
+
+//-----------------------------------------------------------------------------
+// Stage 2: converts token i of an index built over text to out[i], tokens
+// split over up to threads threads (0 takes one per core). A token that is
+// not exactly one number gives 0 and ok[i] = 0 if ok is not null. Returns
+// the number of such tokens.
+template <typename T>
+size_t ConvertTokens(const CharType* text, const StructuralIndex& index,
+                     T* out, ByteType* ok = 0, unsigned int threads = 0);
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__STRUCTURALINDEX_H
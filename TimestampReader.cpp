@@ -0,0 +1,156 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/TimestampReader.h"
+#   include "FastNumberReader/FixedField.h"
+#   include "FastNumberReader/CharScan.h"
+#else
+#   include "TimestampReader.h"
+#   include "FixedField.h"
+#   include "CharScan.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Days since 1970-01-01 of a proleptic Gregorian date.
+static long long DaysFromCivil(int y, int m, int d)
+{
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era * 400;
+    const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (long long)era * 146097 + doe - 719468;
+}
+
+//-----------------------------------------------------------------------------
+static int DaysInMonth(int y, int m)
+{
+    static const int kDays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (m == 2 && (y % 4 == 0) && (y % 100 != 0 || y % 400 == 0))
+        return 29;
+    return kDays[m - 1];
+}
+
+//-----------------------------------------------------------------------------
+TimestampReader::TimestampReader() : value_(0), valid_(false)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+size_t TimestampReader::read(const CharType* str, size_t length)
+{
+    // seconds of the 64-bit nanosecond range, with a little margin
+    const long long kMaxSeconds = 9223372035LL;
+
+    value_ = 0;
+    valid_ = false;
+
+    const CharType* end = str + length;
+    const CharType* p = SkipSpaces(str, end);
+    if (end - p < 10)
+        return 0;
+
+    int year, month, day;
+    if (!(ParseFixedDigits<4>(p, year) & (p[4] == '-') &
+          ParseFixedDigits<2>(p + 5, month) & (p[7] == '-') &
+          ParseFixedDigits<2>(p + 8, day)))
+        return 0;
+    if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month))
+        return 0;
+
+    long long seconds = DaysFromCivil(year, month, day) * 86400;
+    long long nanos = 0;
+    p += 10;
+
+    // the date alone is a valid prefix
+    const CharType* accepted = p;
+    int hour, minute, second;
+    if (end - p >= 9 && (p[0] == 'T' || p[0] == 't' || p[0] == ' ') &&
+        (ParseFixedDigits<2>(p + 1, hour) & (p[3] == ':') &
+         ParseFixedDigits<2>(p + 4, minute) & (p[6] == ':') &
+         ParseFixedDigits<2>(p + 7, second)) &&
+        hour <= 23 && minute <= 59 && second <= 60)
+    {
+        seconds += hour * 3600 + minute * 60 + second;
+        p += 9;
+
+        if (p + 1 < end && *p == '.' && p[1] >= '0' && p[1] <= '9')
+        {
+            ++p;
+            int digits = 0;
+            long long eightDigits;
+            if (end - p >= 8 && ParseFixedDigits<8>(p, eightDigits))
+            {
+                nanos = eightDigits;
+                p += 8;
+                digits = 8;
+            }
+            for (; p < end && *p >= '0' && *p <= '9'; ++p)
+            {
+                if (digits < 9)
+                {
+                    nanos = nanos * 10 + (*p - '0');
+                    ++digits;
+                }
+            }
+            for (; digits < 9; ++digits)
+                nanos *= 10;
+        }
+
+        if (p < end && (*p == 'Z' || *p == 'z'))
+        {
+            ++p;
+        }
+        else if (p < end && (*p == '+' || *p == '-'))
+        {
+            // hh:mm or hhmm, anything else is not UTC but a bad offset
+            const CharType* minutes = p + ((end - p >= 6 && p[3] == ':') ? 4 : 3);
+            int offsetHour, offsetMinute;
+            if (end - minutes < 2 ||
+                !(ParseFixedDigits<2>(p + 1, offsetHour) & ParseFixedDigits<2>(minutes, offsetMinute)) ||
+                offsetHour > 23 || offsetMinute > 59)
+                return 0;
+
+            const int offset = offsetHour * 3600 + offsetMinute * 60;
+            seconds += (*p == '-') ? offset : -offset;
+            p = minutes + 2;
+        }
+        accepted = p;
+    }
+
+    if (seconds > kMaxSeconds || seconds < -kMaxSeconds)
+        return 0;
+
+    value_ = seconds * 1000000000LL + nanos;
+    valid_ = true;
+    return accepted - str;
+}
+
+} // end of fnr
@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__TIMESTAMPREADER_H
+#define FAST_NUMBER_READER__TIMESTAMPREADER_H
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/Config.h"
+#else
+#   include "Config.h"
+#endif
+
+#include <stddef.h>
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+// Reads ISO-8601 / RFC 3339 timestamps in one pass:
+//
+//     YYYY-MM-DD[(T|t| )hh:mm:ss[.fffffffff][Z|z|(+|-)hh[:]mm]]
+//
+// Fractions longer than nanoseconds are truncated, a missing offset means
+// UTC. A sign after the time that starts no valid offset makes the whole
+// timestamp invalid rather than be read as UTC. The value is nanoseconds since the Unix epoch, so only years between
+// 1678 and 2261 are valid.
+class TimestampReader
+{
+public:
+    TimestampReader();
+    // Reads the longest timestamp prefix of str, returns chars consumed (0 if none).
+    size_t read(const CharType* str, size_t length);
+    long long value() const { return value_; }
+    bool valid() const { return valid_; }
+
+private:
+
+    long long value_;
+    bool valid_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__TIMESTAMPREADER_H
@@ -0,0 +1,55 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//#define FNR_INCLUDED_IN_LARGER_PROJECT
+#ifdef FNR_INCLUDED_IN_LARGER_PROJECT
+#   include "FastNumberReader/TokenErrors.h"
+#else
+#   include "TokenErrors.h"
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+TokenErrors::TokenErrors(size_t limit) : limit_(limit)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+bool TokenErrors::add(size_t offset, size_t length, size_t validLength)
+{
+    if (full())
+        return false;
+
+    TokenError error;
+    error.offset = offset;
+    error.length = length;
+    error.reason = validLength ? kTokenTrailingChars : kTokenNotNumber;
+    errors_.push_back(error);
+    return true;
+}
+
+} // end of fnr
@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__TOKENERRORS_H
+#define FAST_NUMBER_READER__TOKENERRORS_H
+
+#include <stddef.h>
+#include <vector>
+
+namespace fnr
+{
+
+enum eTokenError
+{
+    kTokenNotNumber,        // the token does not start with a number
+    kTokenTrailingChars     // a number followed by chars that do not belong to it
+};
+
+struct TokenError
+{
+    size_t offset;          // from the start of the text given to the read
+    size_t length;
+    eTokenError reason;
+};
+
+//-----------------------------------------------------------------------------
+// Side list of malformed tokens for the error-tolerant bulk reads. A read
+// given one records each bad token, resumes at the next separator and goes
+// on instead of stopping, so one bad line costs one entry rather than a
+// fallback to a careful per-line path. With a limit the read stops at the
+// first bad token past it, as it would without a list.
+class TokenErrors
+{
+public:
+    // 0 is no limit
+    explicit TokenErrors(size_t limit = 0);
+
+    // Returns false, recording nothing, if the list already holds limit
+    // errors. validLength is what the reader took of the token.
+    bool add(size_t offset, size_t length, size_t validLength);
+    void clear() { errors_.clear(); }
+
+    size_t size() const { return errors_.size(); }
+    size_t limit() const { return limit_; }
+    bool full() const { return limit_ && errors_.size() >= limit_; }
+    const TokenError& operator[](size_t i) const { return errors_[i]; }
+
+private:
+
+    std::vector<TokenError> errors_;
+    size_t limit_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__TOKENERRORS_H
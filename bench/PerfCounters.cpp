@@ -0,0 +1,183 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "PerfCounters.h"
+
+#include <string.h>
+#include <chrono>
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+namespace fnr
+{
+
+//-----------------------------------------------------------------------------
+static double Now()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#if defined(__linux__)
+//-----------------------------------------------------------------------------
+static int OpenCounter(ePerfCounter counter)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (counter)
+    {
+        case kPerfCycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case kPerfInstructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case kPerfBranchMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case kPerfL1Misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default:
+            return -1;
+    }
+
+    // this thread, any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+PerfCounters::PerfCounters() : startTime_(0.0), seconds_(0.0)
+{
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+#if defined(__linux__)
+        fds_[i] = OpenCounter((ePerfCounter)i);
+#else
+        fds_[i] = -1;
+#endif
+        values_[i] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+        if (fds_[i] >= 0)
+            close(fds_[i]);
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool PerfCounters::anyAvailable() const
+{
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+        if (fds_[i] >= 0)
+            return true;
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+void PerfCounters::start()
+{
+#if defined(__linux__)
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+        if (fds_[i] >= 0)
+            ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+    }
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+        if (fds_[i] >= 0)
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    startTime_ = Now();
+}
+
+//-----------------------------------------------------------------------------
+void PerfCounters::stop()
+{
+    seconds_ = Now() - startTime_;
+
+#if defined(__linux__)
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+        if (fds_[i] >= 0)
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < kPerfCounterCount; ++i)
+    {
+        values_[i] = 0;
+        if (fds_[i] < 0)
+            continue;
+
+        // value, time enabled, time running
+        uint64_t data[3];
+        if (read(fds_[i], data, sizeof(data)) != (ssize_t)sizeof(data) || !data[2])
+            continue;
+        values_[i] = (data[2] < data[1]) ?
+            (uint64_t)((double)data[0] * data[1] / data[2]) : data[0];
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+const char* PerfCounters::Name(ePerfCounter counter)
+{
+    switch (counter)
+    {
+        case kPerfCycles:       return "cycles";
+        case kPerfInstructions: return "instructions";
+        case kPerfBranchMisses: return "branch-misses";
+        case kPerfL1Misses:     return "L1d-read-misses";
+        default: break;
+    }
+    return "";
+}
+
+} // end of fnr
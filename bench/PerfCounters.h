@@ -0,0 +1,82 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FAST_NUMBER_READER__BENCH__PERFCOUNTERS_H
+#define FAST_NUMBER_READER__BENCH__PERFCOUNTERS_H
+
+#include <stdint.h>
+
+namespace fnr
+{
+
+enum ePerfCounter
+{
+    kPerfCycles,
+    kPerfInstructions,
+    kPerfBranchMisses,
+    kPerfL1Misses,          // L1 data cache read misses
+
+    kPerfCounterCount
+};
+
+//-----------------------------------------------------------------------------
+// Hardware counters of the calling thread around a measured region, opened
+// through perf_event_open() on Linux. Each counter is opened on its own, a
+// CPU or a VM that lacks one (or a perf_event_paranoid setting that forbids
+// it) only drops that counter; elsewhere none is available and only the
+// wall time is measured. Counts are scaled up if the kernel had to
+// multiplex the counters.
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    bool available(ePerfCounter counter) const { return fds_[counter] >= 0; }
+    bool anyAvailable() const;
+
+    void start();
+    void stop();
+
+    // of the last start() .. stop()
+    uint64_t value(ePerfCounter counter) const { return values_[counter]; }
+    double seconds() const { return seconds_; }
+
+    static const char* Name(ePerfCounter counter);
+
+private:
+
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+
+    int fds_[kPerfCounterCount];
+    uint64_t values_[kPerfCounterCount];
+    double startTime_;
+    double seconds_;
+
+};
+
+} // end of fnr
+
+#endif // FAST_NUMBER_READER__BENCH__PERFCOUNTERS_H
@@ -0,0 +1,573 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Counter benchmark of the parse kernels and reader specializations: each
+// case runs over a generated buffer and reports throughput together with
+// cycles and instructions per byte and branch and L1 misses per number,
+// the best of several runs. Without perf counters only the wall time is
+// shown. The ingest cases load the data set from a file written to the
+// working directory, which the page cache holds after the first run, so
+// they compare the read paths rather than the storage. Build from the
+// repository root, e.g.
+//
+//   g++ -std=c++11 -O2 -I. bench/*.cpp *.cpp -lpthread -lz -o fnrbench
+//
+// Usage: fnrbench [megabytes per data set] [case name filter]
+
+#include "PerfCounters.h"
+
+#include "NumberReader.h"
+#include "FloatBatch.h"
+#include "IntegerBatch.h"
+#include "HexDecode.h"
+#include "StructuralIndex.h"
+#include "ParseCache.h"
+#include "NumberColumn.h"
+#include "NumberReduce.h"
+#include "FileIngest.h"
+#include "ByteSource.h"
+#include "PullParser.h"
+#include "StreamPipeline.h"
+#include "CompressedSource.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if (FNR_HAS_ZLIB==1)
+#   include <zlib.h>
+#endif
+
+using namespace fnr;
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// Tokens separated by single spaces, with their positions for the kernels
+// that take known boundaries.
+struct Dataset
+{
+    const char* name;
+    std::string text;
+    std::vector<size_t> begins;
+    std::vector<size_t> lengths;
+    std::string path;   // the text as a file, for the ingest cases
+    std::string gzipPath;
+};
+
+typedef double (*RunFunction)(const Dataset& data);
+
+struct BenchCase
+{
+    const char* name;
+    const Dataset* data;
+    RunFunction run;
+};
+
+//-----------------------------------------------------------------------------
+class Random
+{
+public:
+    explicit Random(uint64_t seed) : state_(seed) {}
+
+    unsigned int next(unsigned int range)
+    {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (unsigned int)((state_ >> 33) % range);
+    }
+
+private:
+    uint64_t state_;
+};
+
+//-----------------------------------------------------------------------------
+void AppendDigits(std::string& s, Random& random, unsigned int count, bool leadingNonZero)
+{
+    for (unsigned int i = 0; i < count; ++i)
+        s += (char)('0' + ((i == 0 && leadingNonZero) ? 1 + random.next(9) : random.next(10)));
+}
+
+//-----------------------------------------------------------------------------
+// kind 0: decimals of 1..17 digits, some with an exponent
+// kind 1: integers of 1..9 digits
+// kind 2: short integers of 1..4 digits
+// kind 3: 64-bit hex IDs, "0x" and 16 digits
+void Generate(Dataset& data, const char* name, int kind, size_t bytes)
+{
+    Random random(12345 + kind);
+    data.name = name;
+    data.text.reserve(bytes + 32);
+
+    while (data.text.size() < bytes)
+    {
+        data.begins.push_back(data.text.size());
+        if (kind != 3 && random.next(4) == 0)
+            data.text += '-';
+
+        if (kind == 0)
+        {
+            AppendDigits(data.text, random, 1 + random.next(6), true);
+            data.text += '.';
+            AppendDigits(data.text, random, random.next(11), false);
+            if (random.next(8) == 0)
+            {
+                data.text += 'e';
+                data.text += random.next(2) ? '-' : '+';
+                AppendDigits(data.text, random, 1 + random.next(2), true);
+            }
+        }
+        else if (kind == 3)
+        {
+            data.text += "0x";
+            for (int i = 0; i < 16; ++i)
+                data.text += "0123456789abcdef"[random.next(16)];
+        }
+        else
+        {
+            AppendDigits(data.text, random, 1 + random.next(kind == 1 ? 9 : 4), true);
+        }
+
+        data.lengths.push_back(data.text.size() - data.begins.back());
+        data.text += ' ';
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunRead(const Dataset& data)
+{
+    NumberReader<T> reader;
+    const CharType* text = data.text.data();
+    double sum = 0.0;
+    for (size_t i = 0; i < data.begins.size(); ++i)
+    {
+        reader.read(text + data.begins[i], data.lengths[i]);
+        sum += (double)reader.value();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunPut(const Dataset& data)
+{
+    NumberReader<T> reader;
+    const CharType* text = data.text.data();
+    double sum = 0.0;
+    for (size_t i = 0; i < data.begins.size(); ++i)
+    {
+        const CharType* token = text + data.begins[i];
+        for (size_t k = 0; k < data.lengths[i]; ++k)
+            reader.put(token[k]);
+        sum += (double)reader.value();
+        reader.restore(ReaderState());
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+double RunReadHex64(const Dataset& data)
+{
+    const CharType* text = data.text.data();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < data.begins.size(); ++i)
+    {
+        uint64_t value = 0;
+        ReadHex64(text + data.begins[i], data.lengths[i], value);
+        sum += value;
+    }
+    return (double)sum;
+}
+
+//-----------------------------------------------------------------------------
+double RunReadFloats(const Dataset& data)
+{
+    std::vector<float> out(data.begins.size());
+    const size_t count = ReadFloats(data.text.data(), data.text.size(), DelimiterSet(),
+                                    &out[0], out.size(), 0);
+    return count ? out[count - 1] + (double)count : 0.0;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunReadIntegers(const Dataset& data)
+{
+    std::vector<T> out(data.begins.size());
+    const size_t count = ReadIntegers(data.text.data(), data.text.size(), DelimiterSet(),
+                                      &out[0], out.size(), (size_t*)0);
+    return count ? (double)out[count - 1] + (double)count : 0.0;
+}
+
+//-----------------------------------------------------------------------------
+double RunIndexBuild(const Dataset& data)
+{
+    StructuralIndex index;
+    return (double)index.build(data.text.data(), data.text.size());
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunConvertTokens(const Dataset& data)
+{
+    // the index is part of the measured work, as it is in a real load
+    StructuralIndex index;
+    index.build(data.text.data(), data.text.size());
+    std::vector<T> out(index.size());
+    const size_t failed = ConvertTokens(data.text.data(), index, &out[0], 0, 1);
+    return (double)failed + (out.empty() ? 0.0 : (double)out.back());
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunReduceNumbers(const Dataset& data)
+{
+    NumberSummary summary;
+    ReduceNumbers<T>(data.text.data(), data.text.size(), DelimiterSet(), summary, 1);
+    return summary.sum();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunParseCache(const Dataset& data)
+{
+    ParseCache<T> cache;
+    const CharType* text = data.text.data();
+    double sum = 0.0;
+    for (size_t i = 0; i < data.begins.size(); ++i)
+    {
+        T value = T(0);
+        cache.parse(text + data.begins[i], data.lengths[i], value);
+        sum += (double)value;
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunNumberColumn(const Dataset& data)
+{
+    NumberColumn<T> column;
+    column.read(data.text.data(), data.text.size(), DelimiterSet());
+    return (double)column.size();
+}
+
+//-----------------------------------------------------------------------------
+void WriteFile(Dataset& data)
+{
+    data.path = std::string("fnrbench_") + data.name + ".txt";
+    FILE* file = fopen(data.path.c_str(), "wb");
+    if (file)
+    {
+        fwrite(data.text.data(), 1, data.text.size(), file);
+        fclose(file);
+    }
+#if (FNR_HAS_ZLIB==1)
+    data.gzipPath = data.path + ".gz";
+    gzFile gzip = gzopen(data.gzipPath.c_str(), "wb6");
+    if (gzip)
+    {
+        gzwrite(gzip, data.text.data(), (unsigned int)data.text.size());
+        gzclose(gzip);
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+template <typename T, bool useIoUring>
+double RunIngest(const Dataset& data)
+{
+    std::vector<T> out;
+    out.reserve(data.begins.size());
+    NumberSink<T> sink(out);
+    FileIngest ingest(1 << 20, 4, useIoUring);
+    ingest.run(data.path.c_str(), sink);
+    return (double)sink.failed() + (double)out.size();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunMapped(const Dataset& data)
+{
+    const int fd = open(data.path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || info.st_size == 0)
+        return 0.0;
+    const size_t size = (size_t)info.st_size;
+    void* map = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return 0.0;
+
+    StructuralIndex index;
+    index.build((const CharType*)map, size);
+    std::vector<T> out(index.size());
+    const size_t failed = ConvertTokens((const CharType*)map, index, &out[0], 0, 1);
+    munmap(map, size);
+    return (double)failed + (double)out.size();
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double PullStream(ByteSource& source)
+{
+    PullParser<T> parser;
+    std::vector<CharType> chunk(1 << 20);
+    double sum = 0.0;
+    T value;
+    for (;;)
+    {
+        const ePullStatus status = parser.next(value);
+        if (status == kPullValue)
+        {
+            sum += (double)value;
+        }
+        else if (status == kPullNeedInput)
+        {
+            const long count = source.read(&chunk[0], chunk.size());
+            if (count > 0)
+                parser.feed(&chunk[0], (size_t)count);
+            else
+                parser.finish();
+        }
+        else if (status == kPullEnd)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunPullStream(const Dataset& data)
+{
+    const int fd = open(data.path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0.0;
+    FileSource source(fd);
+    const double sum = PullStream<T>(source);
+    close(fd);
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+class SumSink : public ValueSink<T>
+{
+public:
+    SumSink() : sum(0.0) {}
+    void consume(const T* values, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            sum += (double)values[i];
+    }
+    double sum;
+};
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunPipeline(const Dataset& data)
+{
+    const int fd = open(data.path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0.0;
+    FileSource source(fd);
+    SumSink<T> sink;
+    StreamPipeline<T> pipeline;
+    pipeline.run(source, sink);
+    close(fd);
+    return sink.sum;
+}
+
+#if (FNR_HAS_ZLIB==1)
+//-----------------------------------------------------------------------------
+// Inflates into the parser's window, the text is never held in full.
+template <typename T>
+double RunGzipPull(const Dataset& data)
+{
+    const int fd = open(data.gzipPath.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0.0;
+    FileSource file(fd);
+    GzipSource source(file);
+    const double sum = PullStream<T>(source);
+    close(fd);
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+double RunGzipPipeline(const Dataset& data)
+{
+    const int fd = open(data.gzipPath.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0.0;
+    FileSource file(fd);
+    GzipSource source(file);
+    SumSink<T> sink;
+    StreamPipeline<T> pipeline;
+    pipeline.run(source, sink);
+    close(fd);
+    return sink.sum;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+void PrintHeader(const PerfCounters& counters)
+{
+    if (!counters.anyAvailable())
+    {
+        printf("hardware counters not available (no PMU, or see "
+               "/proc/sys/kernel/perf_event_paranoid), wall time only\n\n");
+    }
+    else
+    {
+        for (int i = 0; i < kPerfCounterCount; ++i)
+        {
+            if (!counters.available((ePerfCounter)i))
+                printf("%s not available\n", PerfCounters::Name((ePerfCounter)i));
+        }
+    }
+
+    printf("%-26s %-9s %9s %8s %7s %7s %6s %10s %10s\n", "case", "data", "MB/s", "ns/num",
+           "cyc/B", "ins/B", "IPC", "brmis/num", "L1mis/num");
+}
+
+//-----------------------------------------------------------------------------
+// Prints value / divisor, or a dash if it was not measured.
+void PrintRatio(bool measured, double value, double divisor, int width, int precision)
+{
+    if (measured && divisor > 0.0)
+        printf(" %*.*f", width, precision, value / divisor);
+    else
+        printf(" %*s", width, "-");
+}
+
+//-----------------------------------------------------------------------------
+void Run(const BenchCase& bench, PerfCounters& counters, int runs)
+{
+    const double bytes = (double)bench.data->text.size();
+    const double numbers = (double)bench.data->begins.size();
+
+    // best run by wall time, the counters of that run
+    double best = 0.0;
+    uint64_t values[kPerfCounterCount] = { 0 };
+    volatile double sink = 0.0;
+    for (int r = 0; r < runs; ++r)
+    {
+        counters.start();
+        sink = sink + bench.run(*bench.data);
+        counters.stop();
+
+        if (r == 0 || counters.seconds() < best)
+        {
+            best = counters.seconds();
+            for (int i = 0; i < kPerfCounterCount; ++i)
+                values[i] = counters.value((ePerfCounter)i);
+        }
+    }
+
+    printf("%-26s %-9s %9.1f %8.2f", bench.name, bench.data->name,
+           bytes / best / 1e6, best * 1e9 / numbers);
+
+    const double cycles = (double)values[kPerfCycles];
+    const double instructions = (double)values[kPerfInstructions];
+    PrintRatio(counters.available(kPerfCycles), cycles, bytes, 7, 2);
+    PrintRatio(counters.available(kPerfInstructions), instructions, bytes, 7, 2);
+    PrintRatio(counters.available(kPerfCycles) && counters.available(kPerfInstructions),
+               instructions, cycles, 6, 2);
+    PrintRatio(counters.available(kPerfBranchMisses),
+               (double)values[kPerfBranchMisses], numbers, 10, 3);
+    PrintRatio(counters.available(kPerfL1Misses), (double)values[kPerfL1Misses], numbers, 10, 3);
+    printf("\n");
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    const size_t megabytes = (argc > 1) ? (size_t)atoi(argv[1]) : 16;
+    const char* filter = (argc > 2) ? argv[2] : "";
+    const int runs = 5;
+
+    Dataset decimals, integers, shorts, hexes;
+    Generate(decimals, "decimal", 0, megabytes << 20);
+    Generate(integers, "integer", 1, megabytes << 20);
+    Generate(shorts, "short", 2, megabytes << 20);
+    Generate(hexes, "hex", 3, megabytes << 20);
+    WriteFile(decimals);
+
+    const BenchCase cases[] =
+    {
+        { "read<double>",           &decimals, RunRead<double> },
+        { "read<float>",            &decimals, RunRead<float> },
+        { "read<long double>",      &decimals, RunRead<long double> },
+        { "read<long>",             &integers, RunRead<long> },
+        { "read<int>",              &integers, RunRead<int> },
+        { "read<short>",            &shorts,   RunRead<short> },
+        { "put<double>",            &decimals, RunPut<double> },
+        { "put<long>",              &integers, RunPut<long> },
+        { "read<long> hex",         &hexes,    RunRead<long> },
+        { "ReadHex64",              &hexes,    RunReadHex64 },
+        { "ReadFloats",             &decimals, RunReadFloats },
+        { "ReadIntegers<long>",     &integers, RunReadIntegers<long> },
+        { "ReadIntegers<short>",    &shorts,   RunReadIntegers<short> },
+        { "StructuralIndex::build", &decimals, RunIndexBuild },
+        { "ConvertTokens<double>",  &decimals, RunConvertTokens<double> },
+        { "ConvertTokens<long>",    &integers, RunConvertTokens<long> },
+        { "ReduceNumbers<double>",  &decimals, RunReduceNumbers<double> },
+        { "ReduceNumbers<long>",    &integers, RunReduceNumbers<long> },
+        { "ParseCache<short>",      &shorts,   RunParseCache<short> },
+        { "NumberColumn<double>",   &decimals, RunNumberColumn<double> },
+        { "ingest io_uring",        &decimals, RunIngest<double, true> },
+        { "ingest pread",           &decimals, RunIngest<double, false> },
+        { "ingest mmap",            &decimals, RunMapped<double> },
+        { "ingest PullParser",      &decimals, RunPullStream<double> },
+        { "ingest StreamPipeline",  &decimals, RunPipeline<double> },
+#if (FNR_HAS_ZLIB==1)
+        { "ingest gzip PullParser", &decimals, RunGzipPull<double> },
+        { "ingest gzip pipeline",   &decimals, RunGzipPipeline<double> },
+#endif
+    };
+
+    PerfCounters counters;
+    PrintHeader(counters);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        if (strstr(cases[i].name, filter))
+            Run(cases[i], counters, runs);
+    }
+
+    remove(decimals.path.c_str());
+    if (!decimals.gzipPath.empty())
+        remove(decimals.gzipPath.c_str());
+    return 0;
+}
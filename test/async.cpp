@@ -0,0 +1,196 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Checks of AsyncParse.h: the ReadNumbers generator, ParseAsync on the
+// epoll loop with tokens cut between awaited chunks, and a source without
+// a descriptor sharing the loop with a pipe. Build from the repository
+// root with C++20, e.g.
+//
+//   g++ -std=c++20 -O2 -I. test/async.cpp *.cpp -lpthread -lz -o fnrasync
+//
+// The exit code is 1 on a failure.
+
+#include "AsyncParse.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if (FNR_HAS_COROUTINES==1) && defined(__linux__)
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace fnr;
+
+namespace
+{
+
+size_t failures = 0;
+
+#define CHECK(condition) \
+    do { if (!(condition)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #condition); ++failures; } } while (0)
+
+//-----------------------------------------------------------------------------
+// Hands out a string in reads of at most step bytes. With open given it
+// has no data while *open is false, and no descriptor to wait on.
+class MemorySource : public ByteSource
+{
+public:
+    MemorySource(const std::string& data, size_t step, const bool* open = 0)
+      : data_(data), pos_(0), step_(step), open_(open), blocks(0)
+    {}
+
+    long read(CharType* buffer, size_t capacity)
+    {
+        if (open_ && !*open_)
+        {
+            ++blocks;
+            return kWouldBlock;
+        }
+        size_t count = data_.size() - pos_;
+        if (count > capacity)
+            count = capacity;
+        if (count > step_)
+            count = step_;
+        if (!count)
+            return kEnd;
+        memcpy(buffer, data_.data() + pos_, count);
+        pos_ += count;
+        return (long)count;
+    }
+
+private:
+
+    std::string data_;
+    size_t pos_;
+    size_t step_;
+    const bool* open_;
+
+public:
+
+    size_t blocks;
+
+};
+
+//-----------------------------------------------------------------------------
+void Sleep(long milliseconds)
+{
+    timespec delay = { 0, milliseconds * 1000000L };
+    nanosleep(&delay, 0);
+}
+
+//-----------------------------------------------------------------------------
+void CheckGenerator()
+{
+    const long expected[] = { 12345, -6, 78, 9000000, 1 };
+    MemorySource source("12345 -6,x, 78\n9000000 ,1", 3);
+    std::vector<long> values;
+    // chunks of 4 chars, so most tokens are cut
+    for (long value : ReadNumbers<long>(source, DelimiterSet(","), 4))
+        values.push_back(value);
+    CHECK(values.size() == 5 && std::equal(values.begin(), values.end(), expected));
+
+    MemorySource empty("", 1);
+    size_t count = 0;
+    for (long value : ReadNumbers<long>(empty))
+    {
+        (void)value;
+        ++count;
+    }
+    CHECK(count == 0);
+}
+
+//-----------------------------------------------------------------------------
+// The writer thread sends the numbers with pauses inside tokens, so the
+// parser waits on the loop with half a token carried.
+void CheckEventLoop()
+{
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+
+    std::thread writer([&fds]()
+    {
+        const char* pieces[] = { "1", "23 4", "5", "6.", "5 -7", "8 9", "\n" };
+        for (size_t i = 0; i < sizeof(pieces) / sizeof(pieces[0]); ++i)
+        {
+            Sleep(5);
+            if (write(fds[1], pieces[i], strlen(pieces[i])) < 0)
+                break;
+        }
+        close(fds[1]);
+    });
+
+    std::vector<long> values;
+    std::vector<double> doubles;
+    bool piped = false;
+    {
+        EventLoop loop;
+        FileSource source(fds[0], true);
+        ParseAsync<long>(loop, source, [&](long value) { values.push_back(value); piped = (value == 9); },
+                         DelimiterSet(), 8);
+
+        // a source without a descriptor has no data until the pipe is
+        // parsed, waiting for it must not keep the pipe from being served
+        MemorySource polled("0.5 1.25 2e3", 2, &piped);
+        ParseAsync<double>(loop, polled, [&](double value) { doubles.push_back(value); });
+
+        loop.run();
+        CHECK(polled.blocks > 0);
+    }
+    writer.join();
+    close(fds[0]);
+
+    // "456.5" is not a long and is skipped
+    const long expected[] = { 123, -78, 9 };
+    CHECK(values.size() == 3 && std::equal(values.begin(), values.end(), expected));
+    CHECK(doubles.size() == 3 && doubles[0] == 0.5 && doubles[1] == 1.25 && doubles[2] == 2000.0);
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    CheckGenerator();
+    CheckEventLoop();
+
+    printf("%s: %lu failures\n", failures ? "FAILED" : "passed", (unsigned long)failures);
+    return failures ? 1 : 0;
+}
+
+#else
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    printf("no coroutines or no epoll, AsyncParse.h is not checked\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Checks of the C interface, built as C so the header is checked as C too.
+Build from the repository root, e.g.
+
+  cc -std=c99 -I. -c test/capi.c -o capi.o
+  g++ -std=c++11 -O2 -I. capi.o *.cpp -lpthread -lz -o fnrcapi
+
+The exit code is 1 on a failure.
+*/
+
+#include "NumberReaderC.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { if (!(condition)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #condition); ++failures; } } while (0)
+
+/*---------------------------------------------------------------------------*/
+static void CheckDoubles(const fnr_reader* reader)
+{
+    const char* text = "1.5, -0.25,3e2 ,.5";
+    double out[8];
+    fnr_result result;
+
+    CHECK(fnr_parse_double(reader, text, strlen(text), out, 8, &result) == FNR_OK);
+    CHECK(result.count == 4 && result.consumed == strlen(text));
+    CHECK(result.error_offset == (size_t)-1);
+    CHECK(out[0] == 1.5 && out[1] == -0.25 && out[2] == 300.0 && out[3] == 0.5);
+    CHECK(fnr_count_tokens(reader, text, strlen(text)) == 4);
+
+    {
+        float values[2];
+        CHECK(fnr_parse_float(reader, "0.1,2.5", 7, values, 2, &result) == FNR_OK);
+        CHECK(result.count == 2 && values[0] == 0.1f && values[1] == 2.5f);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void CheckIntegers(const fnr_reader* reader)
+{
+    fnr_result result;
+
+    {
+        const char* text = "-9223372036854775808 9223372036854775807,0x7f";
+        int64_t out[4];
+        CHECK(fnr_parse_int64(reader, text, strlen(text), out, 4, &result) == FNR_OK);
+        CHECK(result.count == 3);
+        CHECK(out[0] == INT64_MIN && out[1] == INT64_MAX && out[2] == 127);
+    }
+    {
+        const char* text = "1 9223372036854775808";
+        int64_t out[4];
+        CHECK(fnr_parse_int64(reader, text, strlen(text), out, 4, &result) == FNR_ERROR_SYNTAX);
+        CHECK(result.count == 1 && result.error_offset == 2 && result.consumed == 2);
+    }
+    {
+        const char* text = "-2147483648 2147483647 3000000000";
+        int32_t out[4];
+        CHECK(fnr_parse_int32(reader, text, strlen(text), out, 4, &result) == FNR_ERROR_SYNTAX);
+        CHECK(result.count == 2 && result.error_offset == 23);
+        CHECK(out[0] == INT32_MIN && out[1] == INT32_MAX);
+    }
+    {
+        const char* text = "-32768,70000";
+        int16_t out[4];
+        CHECK(fnr_parse_int16(reader, text, strlen(text), out, 4, &result) == FNR_ERROR_SYNTAX);
+        CHECK(result.count == 1 && out[0] == INT16_MIN && result.error_offset == 7);
+    }
+    {
+        const char* text = "12 x3 4";
+        int32_t out[4];
+        CHECK(fnr_parse_int32(reader, text, strlen(text), out, 4, &result) == FNR_ERROR_SYNTAX);
+        CHECK(result.count == 1 && result.error_offset == 3);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void CheckCapacity(const fnr_reader* reader)
+{
+    /* stop on capacity, then continue from consumed */
+    const char* text = "1,2,3,4,5";
+    int32_t out[2];
+    fnr_result result;
+    size_t offset = 0;
+    int32_t sum = 0;
+    size_t i;
+
+    while (offset < strlen(text))
+    {
+        CHECK(fnr_parse_int32(reader, text + offset, strlen(text) - offset,
+                              out, 2, &result) == FNR_OK);
+        CHECK(result.count > 0);
+        if (!result.count)
+            break;
+        for (i = 0; i < result.count; ++i)
+            sum += out[i];
+        offset += result.consumed;
+    }
+    CHECK(sum == 15);
+}
+
+/*---------------------------------------------------------------------------*/
+static void CheckArguments(const fnr_reader* reader)
+{
+    double out[1];
+    fnr_result result;
+
+    CHECK(fnr_parse_double(0, "1", 1, out, 1, &result) == FNR_ERROR_ARGUMENT);
+    CHECK(fnr_parse_double(reader, 0, 1, out, 1, &result) == FNR_ERROR_ARGUMENT);
+    CHECK(fnr_parse_double(reader, "1", 1, 0, 1, &result) == FNR_ERROR_ARGUMENT);
+    CHECK(fnr_parse_double(reader, "1", 1, out, 1, 0) == FNR_ERROR_ARGUMENT);
+    CHECK(fnr_parse_double(reader, "", 0, out, 1, &result) == FNR_OK && result.count == 0);
+    CHECK(fnr_count_tokens(0, "1", 1) == 0);
+}
+
+/*---------------------------------------------------------------------------*/
+int main(void)
+{
+    fnr_reader* reader = fnr_reader_create(",");
+    CHECK(reader != 0);
+    if (!reader)
+        return 1;
+
+    CheckDoubles(reader);
+    CheckIntegers(reader);
+    CheckCapacity(reader);
+    CheckArguments(reader);
+    fnr_reader_destroy(reader);
+
+    printf("%s: %d failures\n", failures ? "FAILED" : "passed", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,290 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Checks of GzipSource and ZstdSource: data of two gzip members or zstd
+// frames, with a token cut by the member boundary, then the same data
+// truncated and corrupted, parsed through PullParser and StreamPipeline.
+// Build from the repository root, e.g.
+//
+//   g++ -std=c++11 -O2 -I. test/compressed.cpp *.cpp -lpthread -lz -o fnrcompressed
+//
+// and add -lzstd with FNR_ZSTD set to 1 in Config.h. The exit code is 1 on
+// a failure.
+
+#include "CompressedSource.h"
+#include "PullParser.h"
+#include "StreamPipeline.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#if (FNR_HAS_ZLIB==1)
+#   include <zlib.h>
+#endif
+#if (FNR_HAS_ZSTD==1)
+#   include <zstd.h>
+#endif
+
+using namespace fnr;
+
+namespace
+{
+
+size_t failures = 0;
+
+#define CHECK(condition) \
+    do { if (!(condition)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #condition); ++failures; } } while (0)
+
+const long kCount = 20000;
+const long long kSum = (long long)kCount * (kCount - 1) / 2;
+
+//-----------------------------------------------------------------------------
+// Hands out a string in reads of at most step bytes.
+class MemorySource : public ByteSource
+{
+public:
+    MemorySource(const std::string& data, size_t step)
+      : data_(data), pos_(0), step_(step)
+    {}
+
+    long read(CharType* buffer, size_t capacity)
+    {
+        size_t count = data_.size() - pos_;
+        if (count > capacity)
+            count = capacity;
+        if (count > step_)
+            count = step_;
+        if (!count)
+            return kEnd;
+        memcpy(buffer, data_.data() + pos_, count);
+        pos_ += count;
+        return (long)count;
+    }
+
+private:
+
+    const std::string& data_;
+    size_t pos_;
+    size_t step_;
+
+};
+
+//-----------------------------------------------------------------------------
+class SumSink : public ValueSink<long>
+{
+public:
+    SumSink() : count(0), sum(0) {}
+
+    void consume(const long* values, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            sum += values[i];
+        count += (long)n;
+    }
+
+    long count;
+    long long sum;
+};
+
+//-----------------------------------------------------------------------------
+// Numbers 0..kCount-1, the second half cut inside a token.
+std::string MakeText(std::string& second)
+{
+    std::string text;
+    char buffer[16];
+    for (long i = 0; i < kCount; ++i)
+    {
+        snprintf(buffer, sizeof(buffer), i % 10 ? " %ld" : "\n%ld", i);
+        text += buffer;
+    }
+    const size_t cut = text.size() / 2 + 3;
+    second = text.substr(cut);
+    return text.substr(0, cut);
+}
+
+//-----------------------------------------------------------------------------
+// Pulls source dry in odd chunks, true if it ends without kError.
+bool Pull(ByteSource& source, SumSink& sink)
+{
+    PullParser<long> parser;
+    std::vector<CharType> chunk(1000);
+    for (;;)
+    {
+        const long count = source.read(&chunk[0], chunk.size());
+        if (count == ByteSource::kError)
+            return false;
+        if (count > 0)
+            parser.feed(&chunk[0], (size_t)count);
+        else
+            parser.finish();
+
+        long value;
+        ePullStatus status;
+        while ((status = parser.next(value)) == kPullValue)
+            sink.consume(&value, 1);
+        if (status == kPullSyntaxError)
+            return false;
+        if (status == kPullEnd)
+            return true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+enum eDecoder { kGzip, kZstd };
+
+bool Decode(eDecoder decoder, const std::string& data, bool pipeline, SumSink& sink)
+{
+    MemorySource compressed(data, 777);
+#if (FNR_HAS_ZLIB==1)
+    if (decoder == kGzip)
+    {
+        GzipSource source(compressed, 100);
+        if (!pipeline)
+            return Pull(source, sink);
+        StreamPipeline<long> parser(2, 1 << 12);
+        return parser.run(source, sink) && !parser.failed();
+    }
+#endif
+#if (FNR_HAS_ZSTD==1)
+    if (decoder == kZstd)
+    {
+        ZstdSource source(compressed, 100);
+        if (!pipeline)
+            return Pull(source, sink);
+        StreamPipeline<long> parser(2, 1 << 12);
+        return parser.run(source, sink) && !parser.failed();
+    }
+#endif
+    (void)compressed;
+    (void)pipeline;
+    (void)sink;
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// secondStart is the offset of the second member or frame in data, corrupt
+// is an offset inside the first one whose damage the format detects.
+void CheckDecoder(eDecoder decoder, const std::string& data, size_t secondStart, size_t corrupt)
+{
+    for (int pipeline = 0; pipeline < 2; ++pipeline)
+    {
+        SumSink whole;
+        CHECK(Decode(decoder, data, pipeline != 0, whole));
+        CHECK(whole.count == kCount && whole.sum == kSum);
+
+        SumSink first;
+        CHECK(Decode(decoder, data.substr(0, secondStart), pipeline != 0, first));
+        CHECK(first.count > 0 && first.count < kCount);
+
+        const size_t cuts[] = { secondStart + 1, (secondStart + data.size()) / 2, data.size() - 1 };
+        for (size_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); ++i)
+        {
+            SumSink truncated;
+            CHECK(!Decode(decoder, data.substr(0, cuts[i]), pipeline != 0, truncated));
+        }
+
+        std::string damaged = data;
+        damaged[secondStart] ^= 0x5A;   // the magic of the second part
+        SumSink badHeader;
+        CHECK(!Decode(decoder, damaged, pipeline != 0, badHeader));
+
+        if (corrupt)
+        {
+            damaged = data;
+            damaged[corrupt] ^= 0x5A;
+            SumSink badData;
+            CHECK(!Decode(decoder, damaged, pipeline != 0, badData));
+        }
+    }
+}
+
+#if (FNR_HAS_ZLIB==1)
+//-----------------------------------------------------------------------------
+std::string Gzip(const std::string& text)
+{
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    deflateInit2(&z, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&z, (uLong)text.size()), '\0');
+    z.next_in = (Bytef*)text.data();
+    z.avail_in = (uInt)text.size();
+    z.next_out = (Bytef*)&out[0];
+    z.avail_out = (uInt)out.size();
+    deflate(&z, Z_FINISH);
+    out.resize(z.total_out);
+    deflateEnd(&z);
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+void CheckGzip()
+{
+    std::string second;
+    const std::string first = MakeText(second);
+    const std::string member = Gzip(first);
+    // the CRC-32 in the trailer catches any damage of the deflate data
+    CheckDecoder(kGzip, member + Gzip(second), member.size(), member.size() / 2);
+}
+#endif
+
+#if (FNR_HAS_ZSTD==1)
+//-----------------------------------------------------------------------------
+std::string Zstd(const std::string& text)
+{
+    std::string out(ZSTD_compressBound(text.size()), '\0');
+    out.resize(ZSTD_compress(&out[0], out.size(), text.data(), text.size(), 3));
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+void CheckZstd()
+{
+    std::string second;
+    const std::string first = MakeText(second);
+    const std::string frame = Zstd(first);
+    // frames carry no checksum by default, only the header damage is sure
+    CheckDecoder(kZstd, frame + Zstd(second), frame.size(), 0);
+}
+#endif
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+#if (FNR_HAS_ZLIB==1)
+    CheckGzip();
+#else
+    printf("no zlib, GzipSource is not checked\n");
+#endif
+#if (FNR_HAS_ZSTD==1)
+    CheckZstd();
+#else
+    printf("no zstd, ZstdSource is not checked\n");
+#endif
+
+    printf("%s: %lu failures\n", failures ? "FAILED" : "passed", (unsigned long)failures);
+    return failures ? 1 : 0;
+}
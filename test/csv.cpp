@@ -0,0 +1,119 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Checks of CsvReader: typed columns, nulls, quoting, and whole numbers in
+// the floating point columns. Build from the repository root, e.g.
+//
+//   g++ -std=c++11 -O2 -I. test/csv.cpp *.cpp -lpthread -lz -o fnrcsv
+//
+// The exit code is 1 on a failure.
+
+#include "CsvReader.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace fnr;
+
+namespace
+{
+
+size_t failures = 0;
+
+#define CHECK(condition) \
+    do { if (!(condition)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #condition); ++failures; } } while (0)
+
+//-----------------------------------------------------------------------------
+void CheckWholeNumbers()
+{
+    const eColumnType schema[] = { kColumnDouble, kColumnFloat, kColumnLongDouble, kColumnInt };
+    const char* text =
+        "100,7,-3,1\n"
+        "2.5,\"8\",1e3,2\n"
+        "-0,+12,12345678901234567890,3\r\n"
+        "5.,0.25f,7.5L,4\n"
+        "1x,7 7,,5";
+
+    CsvReader reader(schema, 4);
+    reader.read(text, strlen(text));
+    CHECK(reader.rowCount() == 5);
+
+    const NumberColumn<double>& doubles = reader.doubles(0);
+    CHECK(doubles.size() == 5 && doubles.nullCount() == 1);
+    CHECK(doubles[0] == 100.0 && doubles[1] == 2.5 && doubles[3] == 5.0);
+    CHECK(doubles.valid(2) && doubles[2] == 0.0);
+    CHECK(!doubles.valid(4));
+
+    const NumberColumn<float>& floats = reader.floats(1);
+    CHECK(floats.size() == 5 && floats.nullCount() == 1);
+    CHECK(floats[0] == 7.0f && floats[1] == 8.0f && floats[2] == 12.0f && floats[3] == 0.25f);
+    CHECK(!floats.valid(4));
+
+    const NumberColumn<long double>& longDoubles = reader.longDoubles(2);
+    CHECK(longDoubles.size() == 5 && longDoubles.nullCount() == 1);
+    CHECK(longDoubles[0] == -3.0L && longDoubles[1] == 1000.0L);
+    CHECK(longDoubles[2] == 12345678901234567890.0L && longDoubles[3] == 7.5L);
+    CHECK(!longDoubles.valid(4));
+
+    const NumberColumn<int>& ints = reader.ints(3);
+    CHECK(ints.size() == 5 && ints.nullCount() == 0 && ints[4] == 5);
+}
+
+//-----------------------------------------------------------------------------
+void CheckNulls()
+{
+    const eColumnType schema[] = { kColumnShort, kColumnSkip, kColumnLong };
+    const char* text =
+        "a,b,c\n"
+        "1, \"x,y\" ,2\n"
+        "70000,,-2147483648\n"
+        "\"3\"\n"
+        " 4 ,z, 0x10 ,extra\n";
+
+    CsvReader reader(schema, 3);
+    reader.setSkipHeader(true);
+    reader.read(text, strlen(text));
+    CHECK(reader.rowCount() == 4);
+
+    const NumberColumn<short>& shorts = reader.shorts(0);
+    CHECK(shorts.size() == 4 && shorts.nullCount() == 1);
+    CHECK(shorts[0] == 1 && !shorts.valid(1) && shorts[2] == 3 && shorts[3] == 4);
+
+    const NumberColumn<long>& longs = reader.longs(2);
+    CHECK(longs.size() == 4 && longs.nullCount() == 1);
+    CHECK(longs[0] == 2 && !longs.valid(2) && longs[3] == 16);
+    CHECK(longs.valid(1) && longs[1] == -2147483647L - 1);
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    CheckWholeNumbers();
+    CheckNulls();
+
+    printf("%s: %lu failures\n", failures ? "FAILED" : "passed", (unsigned long)failures);
+    return failures ? 1 : 0;
+}
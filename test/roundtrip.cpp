@@ -0,0 +1,218 @@
+/*
+MIT License
+
+Copyright (c) 2022 Marat Sungatullin (MrSung, mrsung82, graveman, graveman82)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Round trip of NumberWriter through NumberReader: every value written
+// must read back bit for bit, with the whole output taken as the number.
+// Integers cover 0 and the limits, and one past the limits must not read;
+// floating point types random bit patterns (infinities and NaNs excluded,
+// the readers do not take them).
+// Build from the repository root, e.g.
+//
+//   g++ -std=c++11 -O2 -I. test/roundtrip.cpp *.cpp -lpthread -lz -o fnrroundtrip
+//
+// and once more with -fsanitize=undefined, reading the limits must not
+// overflow.
+//
+// Usage: fnrroundtrip [values per type], the exit code is 1 on a failure.
+
+#include "NumberReader.h"
+#include "NumberWriter.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace fnr;
+
+namespace
+{
+
+size_t failures = 0;
+
+//-----------------------------------------------------------------------------
+uint64_t NextRandom(uint64_t& state)
+{
+    // splitmix64
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+bool SameBits(T a, T b, size_t bytes)
+{
+    return memcmp(&a, &b, bytes) == 0;
+}
+
+//-----------------------------------------------------------------------------
+// bytes: the part of T that holds the value, long double has padding
+template <typename T>
+void Check(const char* type, T value, size_t bytes = sizeof(T))
+{
+    CharType buffer[NumberWriter<T>::kMaxLength];
+    const size_t length = NumberWriter<T>().write(value, buffer);
+
+    NumberReader<T> reader;
+    const size_t read = reader.read(buffer, length);
+    if (read != length || !SameBits(reader.value(), value, bytes))
+    {
+        if (failures < 20)
+            printf("%s: \"%.*s\" read back %s\n", type, (int)length, buffer,
+                   read != length ? "partially" : "as another value");
+        ++failures;
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+void CheckIntegers(const char* type, T low, T high, size_t count, uint64_t& state)
+{
+    const T edges[] = { T(0), T(1), T(-1), T(9), T(10), T(-10), low, high, T(low + 1), T(high - 1) };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i)
+        Check(type, edges[i]);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // random bits, and random lengths so short values are common too
+        const uint64_t bits = NextRandom(state);
+        Check(type, (T)bits);
+        Check(type, (T)(bits >> (NextRandom(state) % 64)));
+    }
+}
+
+//-----------------------------------------------------------------------------
+// one past either limit of T must not read at all, not as a shorter number
+template <typename T>
+void CheckOutOfRange(const char* type, const char* text)
+{
+    NumberReader<T> reader;
+    if (reader.read(text, strlen(text)) != 0)
+    {
+        if (failures < 20)
+            printf("%s: \"%s\" out of range but read\n", type, text);
+        ++failures;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void CheckFloats(size_t count, uint64_t& state)
+{
+    const float edges[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.1f, FLT_MIN, FLT_MAX, -FLT_MAX,
+                            FLT_MIN / 4, 1e-45f, 16777216.0f, 3.4e38f };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i)
+        Check("float", edges[i]);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t bits = (uint32_t)NextRandom(state);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isfinite(value))
+            Check("float", value);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void CheckDoubles(size_t count, uint64_t& state)
+{
+    const double edges[] = { 0.0, -0.0, 1.0, -1.0, 0.1, DBL_MIN, DBL_MAX, -DBL_MAX,
+                             DBL_MIN / 4, 5e-324, 9007199254740992.0, 1e21, 1e-7 };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i)
+        Check("double", edges[i]);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint64_t bits = NextRandom(state);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isfinite(value))
+            Check("double", value);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void CheckLongDoubles(size_t count, uint64_t& state)
+{
+    const long double edges[] = { 0.0L, -0.0L, 1.0L, -1.0L, 0.1L, LDBL_MIN, LDBL_MAX, -LDBL_MAX };
+#if (LDBL_MANT_DIG == 64)
+    const size_t bytes = 10;    // x87 extended, the rest is padding
+#else
+    const size_t bytes = sizeof(long double);
+#endif
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i)
+        Check("long double", edges[i], bytes);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        long double value = 0.0L;
+#if (LDBL_MANT_DIG == 64)
+        // normal numbers only: explicit integer bit set, exponent field
+        // neither 0 (pseudo-denormals) nor all ones
+        const uint64_t mantissa = NextRandom(state) | 0x8000000000000000ULL;
+        const uint64_t random = NextRandom(state);
+        const uint16_t top = (uint16_t)((1 + random % 0x7FFE) | ((random >> 32) & 0x8000));
+        memcpy(&value, &mantissa, 8);
+        memcpy((char*)&value + 8, &top, 2);
+#else
+        const uint64_t bits = NextRandom(state);
+        double shortValue;
+        memcpy(&shortValue, &bits, sizeof(shortValue));
+        value = shortValue;
+#endif
+        if (isfinite(value))
+            Check("long double", value, bytes);
+    }
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    const size_t count = (argc > 1) ? (size_t)atol(argv[1]) : 200000;
+    uint64_t state = 2024;
+
+    CheckIntegers<long>("long", LONG_MIN, LONG_MAX, count, state);
+    CheckIntegers<int>("int", INT_MIN, INT_MAX, count, state);
+    CheckIntegers<short>("short", SHRT_MIN, SHRT_MAX, count, state);
+    CheckOutOfRange<long>("long", sizeof(long) == 8 ? "9223372036854775808" : "2147483648");
+    CheckOutOfRange<long>("long", sizeof(long) == 8 ? "-9223372036854775809" : "-2147483649");
+    CheckOutOfRange<long>("long", "123456789012345678901234567890");
+    CheckOutOfRange<int>("int", "2147483648");
+    CheckOutOfRange<int>("int", "-2147483649");
+    CheckOutOfRange<short>("short", "32768");
+    CheckOutOfRange<short>("short", "-32769");
+    CheckOutOfRange<short>("short", "0x10000");
+    CheckFloats(count, state);
+    CheckDoubles(count, state);
+    CheckLongDoubles(count, state);
+
+    printf("%s: %lu failures\n", failures ? "FAILED" : "passed", (unsigned long)failures);
+    return failures ? 1 : 0;
+}